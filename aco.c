@@ -7,6 +7,186 @@
 #include <time.h>
 #include "aco.h"
 #include "ant_graph.h"
+#include "aco_rng.h"
+
+#define VISITED_WORD_BITS 32 // nodes tracked per word of the visited bitset
+
+// Bump a stats counter if instrumentation is enabled on the colony
+#define STAT_INC(colony, field) do { if ((colony)->stats) (colony)->stats->field++; } while (0)
+
+
+/** Start timing a phase.
+ * @param colony Pointer to the ant colony (timing is skipped if stats are disabled).
+ * @return Start timestamp to pass to phase_end.
+ */
+static inline double phase_begin(const AntColony* colony) {
+    return colony->stats ? aco_clock_seconds() : 0.0;
+}
+
+
+/** Stop timing a phase and add the elapsed time to the colony stats.
+ * @param colony Pointer to the ant colony.
+ * @param phase Phase being timed.
+ * @param t0 Timestamp returned by phase_begin.
+ */
+static inline void phase_end(AntColony* colony, AcoPhase phase, double t0) {
+    if (colony->stats) colony->stats->phase_seconds[phase] += aco_clock_seconds() - t0;
+}
+
+
+/** Read the pheromone level of the trail from u to v.
+ * @param g Pointer to the graph structure.
+ * @param colony Pointer to the ant colony (its private trails win over the graph's).
+ * @param u Source node index.
+ * @param v Destination node index.
+ * @return Pheromone level.
+ */
+static inline double trail_level(const AntGraph* g, const AntColony* colony, int u, int v) {
+    if (colony->pheromone) return pheromone_decode(colony->pheromone[(size_t)u * g->num_nodes + v]);
+    return edge_pheromone(&g->edges[u][v]);
+}
+
+
+/** Store the pheromone level of the trail from u to v.
+ * @param g Pointer to the graph structure.
+ * @param colony Pointer to the ant colony (its private trails win over the graph's).
+ * @param u Source node index.
+ * @param v Destination node index.
+ * @param level Pheromone level.
+ */
+static inline void set_trail_level(AntGraph* g, AntColony* colony, int u, int v, double level) {
+    if (colony->pheromone) colony->pheromone[(size_t)u * g->num_nodes + v] = pheromone_encode(level);
+    else set_edge_pheromone(&g->edges[u][v], level);
+}
+
+
+/** Check whether a node is marked in the visited bitset.
+ * @param visited Packed bitset of visited nodes.
+ * @param node Index of the node to check.
+ * @return Nonzero if the node has been visited.
+ */
+static inline int visited_test(const unsigned int* visited, int node) {
+    return (visited[node / VISITED_WORD_BITS] >> (node % VISITED_WORD_BITS)) & 1u;
+}
+
+
+/** Mark a node in the visited bitset.
+ * @param visited Packed bitset of visited nodes.
+ * @param node Index of the node to mark.
+ */
+static inline void visited_set(unsigned int* visited, int node) {
+    visited[node / VISITED_WORD_BITS] |= 1u << (node % VISITED_WORD_BITS);
+}
+
+
+/** Clear a node from the visited bitset.
+ * @param visited Packed bitset of visited nodes.
+ * @param node Index of the node to clear.
+ */
+static inline void visited_clear(unsigned int* visited, int node) {
+    visited[node / VISITED_WORD_BITS] &= ~(1u << (node % VISITED_WORD_BITS));
+}
+
+
+/** Make sure the colony workspace can track num_nodes nodes.
+ * The bitset is allocated zeroed once and reused; build_path clears only the
+ * bits it set, so no per-ant allocation or full reset is needed.
+ * @param colony Pointer to the ant colony that owns the workspace.
+ * @param num_nodes Total number of nodes in the graph.
+ * @return 0 on success, -1 if memory allocation fails (the workspace is left empty).
+ */
+static int ensure_workspace(AntColony* colony, int num_nodes) {
+    AntWorkspace* ws = &colony->workspace;
+    if (ws->visited && ws->capacity >= num_nodes) return 0; // already big enough
+    free_colony_workspace(colony);
+    int words = (num_nodes + VISITED_WORD_BITS - 1) / VISITED_WORD_BITS;
+    if (words < 1) words = 1;
+    ws->visited = calloc(words, sizeof(unsigned int));
+    ws->visited_back = calloc(words, sizeof(unsigned int));
+    ws->back_path = malloc((num_nodes > 0 ? num_nodes : 1) * sizeof(int));
+    if (!ws->visited || !ws->visited_back || !ws->back_path) { // check allocation
+        free_colony_workspace(colony);
+        return -1;
+    }
+    if (colony->stats) colony->stats->allocations += 3;
+    ws->capacity = num_nodes;
+    return 0;
+}
+
+
+/** Check the colony deadline and remember if it has passed.
+ * @param colony Pointer to the ant colony (deadline of 0 means none).
+ * @return Nonzero if the run should stop now (never when no deadline is set,
+ *         even if an earlier run left deadline_hit set).
+ */
+static int deadline_passed(AntColony* colony) {
+    if (colony->deadline <= 0.0) return 0;
+    if (aco_clock_seconds() >= colony->deadline) colony->deadline_hit = 1;
+    return colony->deadline_hit;
+}
+
+
+/** Make sure the global best path array can hold a path through num_nodes nodes.
+ * @param colony Pointer to the ant colony that owns the global best path.
+ * @param num_nodes Total number of nodes in the graph.
+ * @return 0 on success, -1 if memory allocation fails (the old array is kept).
+ */
+static int ensure_global_best(AntColony* colony, int num_nodes) {
+    if (colony->global_best_path && colony->global_best_capacity >= num_nodes) return 0; // already big enough
+    int* grown = realloc(colony->global_best_path, (num_nodes > 0 ? num_nodes : 1) * sizeof(int));
+    if (!grown) return -1; // check allocation
+    STAT_INC(colony, allocations);
+    colony->global_best_path = grown;
+    colony->global_best_capacity = num_nodes;
+    return 0;
+}
+
+
+/** Initialize a colony with default parameters for a graph of num_nodes nodes.
+ * Callers may adjust any parameter afterwards; the colony starts silent
+ * (no console, no CSV) with an empty global best.
+ * @param colony Pointer to the ant colony to initialize.
+ * @param num_nodes Total number of nodes in the graph.
+ * @return 0 on success, -1 if memory allocation fails.
+ */
+int init_ant_colony(AntColony* colony, int num_nodes) {
+    *colony = (AntColony){
+        .num_ants = 10,
+        .alpha = 1.0,
+        .beta = 2.0,
+        .evaporation_rate = 0.1,
+        .deposit_amount = 1.0,
+        .global_best_length = INT_MAX,
+        .prevent_backtracking = 1,
+        .max_steps = num_nodes
+    };
+    colony->global_best_path = malloc((num_nodes > 0 ? num_nodes : 1) * sizeof(int));
+    if (!colony->global_best_path) return -1;
+    colony->global_best_capacity = num_nodes;
+    return 0;
+}
+
+
+/** Free everything the colony owns (global best path and scratch buffers).
+ * @param colony Pointer to the ant colony to free. The struct itself is not freed.
+ */
+void free_ant_colony(AntColony* colony) {
+    free(colony->global_best_path);
+    colony->global_best_path = NULL;
+    colony->global_best_capacity = 0;
+    free_colony_workspace(colony);
+}
+
+
+/** Free the scratch buffers owned by the colony.
+ * @param colony Pointer to the ant colony that owns the workspace.
+ */
+void free_colony_workspace(AntColony* colony) {
+    free(colony->workspace.visited);
+    free(colony->workspace.visited_back);
+    free(colony->workspace.back_path);
+    colony->workspace = (AntWorkspace){0};
+}
 
 
 /**
@@ -14,38 +194,40 @@
  * @param g Pointer to the graph structure.
  * @param current Index of the current node.
  * @param previous Index of the previous node (to prevent backtracking).
- * @param visited Array indicating which nodes have been visited.
+ * @param visited Packed bitset of visited nodes (one bit per node).
  * @param num_nodes Total number of nodes in the graph.
  * @param colony Pointer to the ant colony (contains parameters like alpha, beta, etc.).
  * @return Index of the next node to move to, or -1 if no valid move exists.
  */
-int pick_next_node(AntGraph* g, int current, int previous, int* visited, int num_nodes, AntColony* colony) {
+int pick_next_node(AntGraph* g, int current, int previous, const unsigned int* visited, int num_nodes, AntColony* colony) {
     double exploration_prob = 0.05; // 5% chance the ant ignores pheromones and picks randomly
     // Collect all valid neighbors of the current node
     int valid_count = 0; // how many valid neighbors we find
     int valid_nodes[num_nodes]; // store their indices
     for (int j = 0; j < num_nodes; j++) {
         // Skip if: no edge exists, backtracking is prevented and j==previous, or node already visited
-        if (!g->edges[current][j].exists || (colony->prevent_backtracking && j == previous) || visited[j])
+        if (!g->edges[current][j].exists || (colony->prevent_backtracking && j == previous) || visited_test(visited, j))
             continue;
         valid_nodes[valid_count++] = j; // add neighbor to the list
     }
     // Random exploration: with 5% probability, pick a random neighbor from the valid list
-    if (valid_count > 0 && ((double)rand() / RAND_MAX) < exploration_prob) {
-        return valid_nodes[rand() % valid_count]; // choose one at random
+    if (valid_count > 0 && aco_rng_uniform(&colony->rng_state) < exploration_prob) {
+        STAT_INC(colony, exploration_picks);
+        return valid_nodes[aco_rng_below(&colony->rng_state, valid_count)]; // choose one at random
     }
     // Otherwise, calculate probability based on pheromone and heuristic (distance)
     double* appeal = malloc(num_nodes * sizeof(double)); // array to store appeal values
     if (!appeal) return -1; // if memory allocation fails, return -1
+    STAT_INC(colony, allocations);
 
     double total = 0.0; // sum of all appeal values
     for (int j = 0; j < num_nodes; j++) {
         // Skip invalid neighbors (same checks as before)
-        if (!g->edges[current][j].exists || (colony->prevent_backtracking && j == previous) || visited[j]) {
+        if (!g->edges[current][j].exists || (colony->prevent_backtracking && j == previous) || visited_test(visited, j)) {
             appeal[j] = 0; // no appeal for invalid moves
             continue;
         }
-        double pher = g->edges[current][j].pheromone; // pheromone level on edge
+        double pher = trail_level(g, colony, current, j); // pheromone level on edge
         double heur = 1.0 / g->edges[current][j].weight; // heuristic: inverse of edge weight (shorter = better)
         // Appeal = pheromone^alpha * heuristic^beta
         appeal[j] = pow(pher, colony->alpha) * pow(heur, colony->beta);
@@ -57,7 +239,7 @@ int pick_next_node(AntGraph* g, int current, int previous, int* visited, int num
         return -1;
     }
     // Roulette wheel selection: pick a neighbor proportional to its appeal
-    double r = ((double)rand() / RAND_MAX) * total; // random threshold between 0 and total
+    double r = aco_rng_uniform(&colony->rng_state) * total; // random threshold between 0 and total
     double cumulative = 0.0;
     for (int j = 0; j < num_nodes; j++) {
         cumulative += appeal[j]; // accumulate appeal
@@ -67,6 +249,7 @@ int pick_next_node(AntGraph* g, int current, int previous, int* visited, int num
         }
     }
     // If roulette wheel fails, pick the node with highest appeal
+    STAT_INC(colony, roulette_fallthroughs);
     int best = -1;
     double best_appeal = -1;
     for (int j = 0; j < num_nodes; j++) {
@@ -80,6 +263,95 @@ int pick_next_node(AntGraph* g, int current, int previous, int* visited, int num
 }
 
 
+/**
+ * Build a path by walking from both ends and joining where the walks meet.
+ * A forward walk leaves start and a backward walk leaves end, taking turns.
+ * Each walk avoids its own visited nodes; the first time either one steps
+ * onto a node the other has visited, the two halves are stitched into a
+ * simple start-to-end path. If one walk hits a dead end the other keeps
+ * going alone (it can still reach any node of the stuck walk).
+ * @param g Pointer to the graph structure.
+ * @param start Index of the starting node.
+ * @param end Index of the target node.
+ * @param num_nodes Total number of nodes in the graph.
+ * @param path Array to store the stitched path (at least num_nodes ints).
+ * @param path_length Pointer to an integer where the final path length is written.
+ * @param colony Pointer to the ant colony (workspace must already fit num_nodes).
+ */
+static void build_path_bidirectional(AntGraph* g, int start, int end, int num_nodes, int* path, int* path_length, AntColony* colony) {
+    if (start == end) { // nothing to walk
+        path[0] = start;
+        *path_length = 1;
+        return;
+    }
+    AntWorkspace* ws = &colony->workspace;
+    // Side 0 walks forward from start into path, side 1 walks backward from end
+    unsigned int* visited[2] = {ws->visited, ws->visited_back};
+    int* nodes[2] = {path, ws->back_path};
+    int count[2] = {1, 1}; // nodes walked by each side
+    int current[2] = {start, end};
+    int previous[2] = {-1, -1};
+    int alive[2] = {1, 1}; // cleared when a side hits a dead end
+    nodes[0][0] = start;
+    nodes[1][0] = end;
+    visited_set(visited[0], start);
+    visited_set(visited[1], end);
+
+    int meet_side = -1; // side whose move joined the walks
+    int meet_node = -1; // node where they joined
+    int side = 0;
+    // Combined moves of both sides are capped like a single ant's walk
+    for (int steps = 0; steps < num_nodes && (alive[0] || alive[1]); steps++) {
+        if (!alive[side]) side = 1 - side; // the other side keeps walking alone
+        int next = pick_next_node(g, current[side], previous[side], visited[side], num_nodes, colony);
+        if (next == -1) {
+            alive[side] = 0;
+            side = 1 - side;
+            continue;
+        }
+        STAT_INC(colony, ant_steps);
+        // Stepping onto the other side's trail completes the path
+        if (visited_test(visited[1 - side], next)) {
+            meet_side = side;
+            meet_node = next;
+            break;
+        }
+        nodes[side][count[side]++] = next;
+        visited_set(visited[side], next);
+        previous[side] = current[side];
+        current[side] = next;
+        side = 1 - side; // take turns
+    }
+    if (meet_side == -1 && !alive[0] && !alive[1]) STAT_INC(colony, dead_ends);
+    // Reset the bits both sides set, before the forward nodes are overwritten below
+    for (int s = 0; s < 2; s++) {
+        for (int i = 0; i < count[s]; i++) visited_clear(visited[s], nodes[s][i]);
+    }
+    if (meet_side == -1) { // walks never met
+        *path_length = 0;
+        return;
+    }
+    // Find the meeting node on the trail that was stepped onto
+    int other = 1 - meet_side;
+    int meet_idx = 0;
+    while (nodes[other][meet_idx] != meet_node) meet_idx++;
+    // Keep the forward nodes up to the meeting node, then append the backward nodes in reverse
+    int length, back_from;
+    if (meet_side == 0) {
+        path[count[0]] = meet_node;
+        length = count[0] + 1;
+        back_from = meet_idx - 1;
+    } else {
+        length = meet_idx + 1;
+        back_from = count[1] - 1;
+    }
+    for (int i = back_from; i >= 0; i--) {
+        path[length++] = ws->back_path[i];
+    }
+    *path_length = length;
+}
+
+
 /**
  * Build a path for a single ant from start to end.
  * @param g Pointer to the graph structure.
@@ -89,39 +361,51 @@ int pick_next_node(AntGraph* g, int current, int previous, int* visited, int num
  * @param path Array to store the sequence of nodes visited.
  * @param path_length Pointer to an integer where the final path length is written.
  * @param colony Pointer to the ant colony (contains parameters like alpha, beta, etc.).
+ * @return 0 on success, -1 if the workspace could not be allocated (path_length is set to 0).
  */
-void build_path(AntGraph* g, int start, int end, int num_nodes, int* path, int* path_length, AntColony* colony) {
-    // Track which nodes have been visited (initialized to 0)
-    int* visited = calloc(num_nodes, sizeof(int));
+int build_path(AntGraph* g, int start, int end, int num_nodes, int* path, int* path_length, AntColony* colony) {
+    // Track which nodes have been visited in the colony's reusable bitset
+    if (ensure_workspace(colony, num_nodes) != 0) {
+        *path_length = 0;
+        return -1;
+    }
+    if (colony->bidirectional) {
+        build_path_bidirectional(g, start, end, num_nodes, path, path_length, colony);
+        return 0;
+    }
+    unsigned int* visited = colony->workspace.visited;
     int current = start; // current node
     int previous = -1; // previous node (none at the start)
     int idx = 0; // index in the path array
     int max_steps = num_nodes; // maximum steps allowed (avoid infinite loops)
     // Place the starting node into the path
     path[idx++] = current;
-    visited[current] = 1;
+    visited_set(visited, current);
     // Walk through the graph until reaching the end or hitting max steps
     for (int steps = 0; steps < max_steps; steps++) {
         if (current == end) break; // stop if target reached
         // Decide the next node using pheromone + heuristic rules
         int next = pick_next_node(g, current, previous, visited, num_nodes, colony);
-        // If no valid move is found, mark path as invalid and exit
+        // If no valid move is found, stop walking (path is marked invalid below)
         if (next == -1) {
-            *path_length = 0;
-            free(visited);
-            return;
+            STAT_INC(colony, dead_ends);
+            break;
         }
+        STAT_INC(colony, ant_steps);
         // Add the chosen node to the path
         path[idx++] = next;
-        visited[next] = 1;
+        visited_set(visited, next);
         // Update current and previous for the next step
         previous = current;
         current = next;
     }
     // If we ended at the target, record the path length; otherwise mark as invalid
     *path_length = (current == end) ? idx : 0;
-    // Free memory used for visited tracking
-    free(visited);
+    // Reset only the bits this ant set: the path holds exactly the visited nodes
+    for (int i = 0; i < idx; i++) {
+        visited_clear(visited, path[i]);
+    }
+    return 0;
 }
 
 
@@ -141,27 +425,6 @@ static double compute_path_cost(AntGraph* g, const int* path, int path_length) {
 }
 
 
-/**
- * Log one ant's path to both console and a logfile.
- * @param logfile File stream to write the path into.
- * @param path Array containing the sequence of nodes visited.
- * @param path_length Number of nodes in the path.
- * @param ant_id Identifier of the ant whose path is being logged.
- */
-static void log_ant_path(FILE* logfile, int* path, int path_length, int ant_id) {
-    // Print header with ant ID
-    printf("  Ant %d path:", ant_id);
-    fprintf(logfile, "  Ant %d path:", ant_id);
-    // Print each node in the path
-    for (int i = 0; i < path_length; i++) {
-        printf(" %d", path[i]);
-        fprintf(logfile, " %d", path[i]);
-    }
-    printf("\n");
-    fprintf(logfile, "\n");
-}
-
-
 /**
  * Deposit pheromones along the path taken by an ant.
  * @param g Pointer to the graph structure.
@@ -179,11 +442,13 @@ static void deposit_pheromones(AntGraph* g, int* path, int path_length, AntColon
         int u = path[i]; // current node
         int v = path[i + 1]; // next node
         // Add pheromone to both directions of the edge
-        g->edges[u][v].pheromone += deposit;
-        g->edges[v][u].pheromone += deposit;
+        double forward = trail_level(g, colony, u, v) + deposit;
+        double backward = trail_level(g, colony, v, u) + deposit;
         // Clamp pheromone values to stay within reasonable bounds
-        if (g->edges[u][v].pheromone < 0.01) g->edges[u][v].pheromone = 0.01; // minimum floor
-        if (g->edges[u][v].pheromone > 10.0) g->edges[u][v].pheromone = 10.0; // maximum cap
+        if (forward < 0.01) forward = 0.01; // minimum floor
+        if (forward > 10.0) forward = 10.0; // maximum cap
+        set_trail_level(g, colony, u, v, forward);
+        set_trail_level(g, colony, v, u, backward);
     }
 }
 
@@ -200,8 +465,9 @@ static void evaporate_pheromones(AntGraph* g, AntColony* colony) {
         for (int j = 0; j < g->num_nodes; j++) {
             // Only evaporate if the edge exists
             if (g->edges[i][j].exists) {
-                g->edges[i][j].pheromone *= (1.0 - colony->evaporation_rate);
-                if (g->edges[i][j].pheromone < 0.01) g->edges[i][j].pheromone = 0.01;
+                double level = trail_level(g, colony, i, j) * (1.0 - colony->evaporation_rate);
+                if (level < 0.01) level = 0.01;
+                set_trail_level(g, colony, i, j, level);
             }
         }
     }
@@ -209,7 +475,8 @@ static void evaporate_pheromones(AntGraph* g, AntColony* colony) {
 
 
 /** Log the best path found in the current iteration to console, logfile, and CSV.
- * @param logfile File stream to write logs into.
+ * With a background logger attached the record is queued instead of written.
+ * @param logfile File stream to write logs into, or NULL.
  * @param iteration Current iteration number.
  * @param g Pointer to the graph structure.
  * @param best_path Array containing the best path found this iteration.
@@ -217,39 +484,27 @@ static void evaporate_pheromones(AntGraph* g, AntColony* colony) {
  * @param colony Pointer to the ant colony (for global best info).
  */
 static void log_iteration_best(FILE* logfile, int iteration, AntGraph* g, int* best_path, int best_length, AntColony* colony) {
-    // Compute the cost of the best path
-    double cost = compute_path_cost(g, best_path, best_length);
-    
-    // Log to console and logfile
-    printf("  Best path node count this iteration: %d\n", best_length);
-    fprintf(logfile, "  Best path node count this iteration: %d\n", best_length);
-
-    printf("  Best path weighted cost this iteration: %.2f\n", cost);
-    fprintf(logfile, "  Best path weighted cost this iteration: %.2f\n", cost);
-
-    printf("  Best path:");
-    fprintf(logfile, "  Best path:");
-    // Print each node in the best path
-    for (int i = 0; i < best_length; i++) {
-        printf(" %d", best_path[i]);
-        fprintf(logfile, " %d", best_path[i]);
-    }
-    printf("\n");
-    fprintf(logfile, "\n");
-    // Log to CSV file
-    double chain_cost = 1.1 * (g->num_nodes - 1); // expected cost of the chain path
-    double norm = cost / chain_cost; // normalized cost
-    // Append to convergence.csv
-    FILE* csv = fopen("convergence.csv", "a");
-    if (csv) {
-        double global_cost = compute_path_cost(g, colony->global_best_path, colony->global_best_length); // global best cost
-        double improvement = chain_cost / cost; // improvement factor this iteration
-        // Write a row with iteration data
-        fprintf(csv, "%d,%d,%.2f,%.4f,%d,%.2f,%.4f,%.2f,%.2f,%.2f,%.2f\n", iteration + 1, best_length, 
-            cost, norm, colony->global_best_length, global_cost, improvement, colony->alpha, colony->beta,
-            colony->evaporation_rate, colony->deposit_amount);
-        fclose(csv);
+    // Collect the figures written to the log and CSV
+    AcoIterationSummary summary = {
+        .iteration = iteration,
+        .best_length = best_length,
+        .best_cost = compute_path_cost(g, best_path, best_length),
+        .global_best_length = colony->global_best_length,
+        .global_best_cost = compute_path_cost(g, colony->global_best_path, colony->global_best_length),
+        .num_nodes = g->num_nodes,
+        .alpha = colony->alpha,
+        .beta = colony->beta,
+        .evaporation_rate = colony->evaporation_rate,
+        .deposit_amount = colony->deposit_amount
+    };
+    if (colony->logger) {
+        aco_logger_push_iteration_best(colony->logger, &summary, best_path);
+        return;
     }
+    // Append to the convergence CSV, if one is configured
+    FILE* csv = colony->convergence_csv ? fopen(colony->convergence_csv, "a") : NULL;
+    write_iteration_best(colony->console, logfile, csv, &summary, best_path);
+    if (csv) fclose(csv);
 }
 
 
@@ -259,29 +514,44 @@ static void log_iteration_best(FILE* logfile, int iteration, AntGraph* g, int* b
  * @param start Index of the starting node.
  * @param end Index of the target node.
  * @param iteration Current iteration number.
- * @param logfile File stream to write logs into.
- * @return Number of ants that found the optimal path (for convergence tracking).
+ * @param logfile File stream to write logs into, or NULL.
+ * @return Number of ants that found the optimal path (for convergence tracking),
+ *         or -1 if memory allocation fails (the colony keeps its previous global best).
  */
 int run_iteration(AntGraph* g, AntColony* colony, int start, int end, int iteration, FILE* logfile) {
     if (!g || !colony) return 0;
+    if (deadline_passed(colony)) return 0; // out of time before this iteration started
 
-    printf("Iteration %d:\n", iteration + 1);
-    fprintf(logfile, "Iteration %d:\n", iteration + 1);
+    double t0 = phase_begin(colony);
+    if (colony->logger) aco_logger_push_iteration(colony->logger, iteration);
+    else write_iteration_header(colony->console, logfile, iteration);
+    phase_end(colony, ACO_PHASE_LOGGING, t0);
 
     int max_steps = g->num_nodes; // set max steps to number of nodes
     colony->max_steps = max_steps; // update colony max steps
+    if (ensure_global_best(colony, g->num_nodes) != 0) return -1; // global best must fit any simple path
 
     int *best_path = malloc(max_steps * sizeof(int)); // allocate for best path
-    if (!best_path) { fprintf(stderr, "Memory allocation failed\n"); exit(1); } // check allocation
+    int *path = malloc(max_steps * sizeof(int)); // reused by every ant this iteration
+    if (!best_path || !path) { // check allocation
+        free(best_path);
+        free(path);
+        return -1;
+    }
+    if (colony->stats) colony->stats->allocations += 2;
     int best_length = INT_MAX; // initialize best length to max
 
     // Track how many ants found the optimal path
     for (int a = 0; a < colony->num_ants; a++) {
-        int *path = malloc(max_steps * sizeof(int)); // allocate for this ant's path
-        if (!path) { fprintf(stderr, "Memory allocation failed\n"); exit(1); } // check allocation
+        if (deadline_passed(colony)) break; // stop sending ants once the deadline passes
         int path_length = 0; // initialize path length
         // Build path for this ant
-        build_path(g, start, end, g->num_nodes, path, &path_length, colony); 
+        t0 = phase_begin(colony);
+        if (build_path(g, start, end, g->num_nodes, path, &path_length, colony) != 0) {
+            free(best_path);
+            free(path);
+            return -1;
+        }
 
         if (path_length > 0 && path[path_length - 1] == end) {
             // Track the iteration best path
@@ -294,50 +564,73 @@ int run_iteration(AntGraph* g, AntColony* colony, int start, int end, int iterat
                 int copy_len = (path_length > colony->global_best_capacity) ? colony->global_best_capacity : path_length;
                 memcpy(colony->global_best_path, path, copy_len * sizeof(int)); // copy global best path
                 colony->global_best_length = path_length;
+                // Report the improvement right away so callers can serve it early
+                if (colony->on_improve) {
+                    colony->on_improve(colony->global_best_path, path_length,
+                        compute_path_cost(g, colony->global_best_path, path_length), iteration,
+                        colony->on_improve_data);
+                }
             }
         }
+        phase_end(colony, ACO_PHASE_CONSTRUCTION, t0);
         // Log this ant's path
-        log_ant_path(logfile, path, path_length, a);
-        free(path);
-    }
-    // Deposit pheromones for iteration best
-    if (best_length < INT_MAX) {
-        deposit_pheromones(g, best_path, best_length, colony); // iteration best
+        t0 = phase_begin(colony);
+        if (colony->logger) aco_logger_push_ant_path(colony->logger, a, path, path_length);
+        else write_ant_path(colony->console, logfile, a, path, path_length);
+        phase_end(colony, ACO_PHASE_LOGGING, t0);
     }
-    // Deposit pheromones for global best
-    if (colony->global_best_length < INT_MAX) {
-        deposit_pheromones(g, colony->global_best_path, colony->global_best_length, colony); // global best
+    free(path);
+    // Pheromone updates only help later iterations, so skip them when out of time
+    if (!deadline_passed(colony)) {
+        // Deposit pheromones for iteration best
+        t0 = phase_begin(colony);
+        if (best_length < INT_MAX) {
+            deposit_pheromones(g, best_path, best_length, colony); // iteration best
+        }
+        // Deposit pheromones for global best
+        if (colony->global_best_length < INT_MAX) {
+            deposit_pheromones(g, colony->global_best_path, colony->global_best_length, colony); // global best
+        }
+        phase_end(colony, ACO_PHASE_DEPOSIT, t0);
+        // Evaporate pheromones after deposition
+        t0 = phase_begin(colony);
+        evaporate_pheromones(g, colony);
+        phase_end(colony, ACO_PHASE_EVAPORATION, t0);
     }
-    // Evaporate pheromones after deposition
-    evaporate_pheromones(g, colony);
     // Log iteration best to CSV/console
+    t0 = phase_begin(colony);
     if (best_length < INT_MAX) {
         log_iteration_best(logfile, iteration, g, best_path, best_length, colony);
     }
+    phase_end(colony, ACO_PHASE_LOGGING, t0);
     free(best_path);
+    // Record the iteration in the stats and dump them if a JSON stream is attached
+    if (colony->stats) {
+        colony->stats->iterations++;
+        if (colony->stats->json_out) {
+            colony->stats->peak_rss_kb = measure_peak_rss_kb();
+            write_aco_stats_json(colony->stats, colony->stats->json_out);
+        }
+    }
     return 0;
 }
 
 
 
 /** Log the global best path found by the colony.
- * @param logfile File stream to write logs into.
+ * @param logfile File stream to write logs into, or NULL.
  * @param colony Pointer to the ant colony (contains global best info).
  */
 static void log_global_best(FILE* logfile, AntColony* colony) {
     if (colony->global_best_length < INT_MAX) { // check if a global best exists
-        printf("Global best path length: %d\n", colony->global_best_length);
-        fprintf(logfile, "Global best path length: %d\n", colony->global_best_length);
+        write_both(colony->console, logfile, "Global best path length: %d\n", colony->global_best_length);
 
-        printf("Global best path:");
-        fprintf(logfile, "Global best path:");
+        write_both(colony->console, logfile, "Global best path:");
         // Print each node in the global best path
         for (int i = 0; i < colony->global_best_length; i++) {
-            printf(" %d", colony->global_best_path[i]);
-            fprintf(logfile, " %d", colony->global_best_path[i]);
+            write_both(colony->console, logfile, " %d", colony->global_best_path[i]);
         }
-        printf("\n");
-        fprintf(logfile, "\n");
+        write_both(colony->console, logfile, "\n");
     }
 }
 
@@ -348,14 +641,14 @@ static void log_global_best(FILE* logfile, AntColony* colony) {
  * @param start Index of the starting node.
  * @param end Index of the target node.
  * @param iterations Number of iterations to run.
- * @param logfile File stream to write logs into.
+ * @param logfile File stream to write logs into, or NULL.
+ * @return 0 on success, -1 if memory allocation fails (the run stops early).
  */
-void run_aco(AntGraph* g, AntColony* colony, int start, int end, int iterations, FILE* logfile) {
+int run_aco(AntGraph* g, AntColony* colony, int start, int end, int iterations, FILE* logfile) {
     // Announce start of ACO to console and logfile
-    printf("Starting ACO with %d ants, %d iterations.\n", colony->num_ants, iterations);
-    fprintf(logfile, "Starting ACO with %d ants, %d iterations.\n", colony->num_ants, iterations);
+    write_both(colony->console, logfile, "Starting ACO with %d ants, %d iterations.\n", colony->num_ants, iterations);
     // Create CSV file to record convergence data, will overwrite existing
-    FILE* csv = fopen("convergence.csv", "w");
+    FILE* csv = colony->convergence_csv ? fopen(colony->convergence_csv, "w") : NULL;
     if (csv) {
         // Write CSV header row for column names
         fprintf(csv, "Iteration,BestPathLength,BestPathCost,NormBestCost,GlobalBestLength,GlobalBestCost,"
@@ -363,19 +656,28 @@ void run_aco(AntGraph* g, AntColony* colony, int start, int end, int iterations,
         fclose(csv);
     }
     colony->global_best_length = INT_MAX; // initialize global best length
-    // Allocate memory for global best path
-    for (int iteration = 0; iteration < iterations; iteration++) {
-        run_iteration(g, colony, start, end, iteration, logfile);
+    colony->deadline_hit = 0; // a new run has not timed out yet
+    // Run iterations until done or until the deadline passes
+    int completed = 0;
+    while (completed < iterations && !deadline_passed(colony)) {
+        if (run_iteration(g, colony, start, end, completed, logfile) < 0) {
+            if (colony->logger) aco_logger_flush(colony->logger); // nothing queued may outlive the run
+            return -1;
+        }
+        completed++;
     }
+    // Let the background logger catch up so the summary lines come last
+    if (colony->logger) aco_logger_flush(colony->logger);
     // Announce completion of ACO to console and logfile
-    printf("ACO finished after %d iterations.\n", iterations);
-    fprintf(logfile, "ACO finished after %d iterations.\n", iterations);
+    write_both(colony->console, logfile, "ACO finished after %d iterations.\n", completed);
 
     // use helper for global best logging
     log_global_best(logfile, colony);
+    // Record the real peak memory of the run
+    if (colony->stats) colony->stats->peak_rss_kb = measure_peak_rss_kb();
 
-    // Final entry to convergence CSV
-    csv = fopen("convergence.csv", "a");
+    // Final entry to convergence CSV (only if a path was found)
+    csv = (colony->global_best_length < INT_MAX && colony->convergence_csv) ? fopen(colony->convergence_csv, "a") : NULL;
     if (csv) {
         // Calculate final metrics for logging
         double global_cost = compute_path_cost(g, colony->global_best_path, colony->global_best_length);
@@ -388,4 +690,5 @@ void run_aco(AntGraph* g, AntColony* colony, int start, int end, int iterations,
                 colony->beta, colony->evaporation_rate, colony->deposit_amount);
         fclose(csv);
     }
+    return 0;
 }
\ No newline at end of file
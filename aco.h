@@ -4,6 +4,17 @@
 
 #include <stdio.h>
 #include "ant_graph.h"
+#include "aco_stats.h"
+#include "aco_log.h"
+#include "aco_types.h"
+
+// Scratch buffers reused by every ant so path construction does not allocate
+typedef struct {
+    unsigned int* visited; // Packed bitset of visited nodes (32 nodes per word)
+    unsigned int* visited_back; // Visited bitset of the backward walk in bidirectional mode
+    int* back_path; // Nodes of the backward walk in bidirectional mode
+    int capacity; // Number of nodes the buffers can hold
+} AntWorkspace;
 
 // Definition of the AntColony structure
 typedef struct {
@@ -20,15 +31,37 @@ typedef struct {
     int prevent_backtracking; // Flag to prevent ants from immediately returning to previous node
     int max_steps; // Maximum steps an ant can take in a single path
     int use_global_best_update; // Flag to control whether global best is reinforced each iteration
+    int bidirectional; // Flag to walk from both start and end and join the walks in the middle
+
+    AntWorkspace workspace; // Per-colony scratch space (zero-initialize before first use)
+    AcoStats* stats; // Optional instrumentation (NULL disables counters and timers)
+
+    FILE* console; // Stream that echoes progress, e.g. stdout (NULL keeps the colony silent)
+    const char* convergence_csv; // Path of the convergence CSV to write (NULL disables it)
+    unsigned long long rng_state; // Per-colony random state, doubles as the seed
+    AcoLogger* logger; // Optional background writer for per-iteration output (NULL writes synchronously)
+
+    double deadline; // aco_clock_seconds() time at which to stop, checked before each ant (0 for none)
+    int deadline_hit; // Set when the last run stopped because the deadline passed
+    AcoImproveCallback on_improve; // Optional callback fired when the global best improves
+    void* on_improve_data; // User pointer passed to on_improve
+
+    aco_pheromone_t* pheromone; // Optional private trails, num_nodes^2 row-major, not owned (NULL uses the graph's)
 } AntColony;
 
-// Run the Ant Colony Optimization algorithm.
-void run_aco(AntGraph* g, AntColony* colony, int start, int end, int iterations, FILE* logfile);
+// Run the Ant Colony Optimization algorithm (-1 if memory allocation fails).
+int run_aco(AntGraph* g, AntColony* colony, int start, int end, int iterations, FILE* logfile);
 // Pick the next node for an ant to move to.
-int pick_next_node(AntGraph* g, int current, int previous, int* visited, int num_nodes, AntColony* colony);
-// Build a path for an ant from start to end.
-void build_path(AntGraph* g, int start, int end, int num_nodes, int* path, int* path_length, AntColony* colony);
-// Run a single iteration of the ACO algorithm.
+int pick_next_node(AntGraph* g, int current, int previous, const unsigned int* visited, int num_nodes, AntColony* colony);
+// Build a path for an ant from start to end (-1 if memory allocation fails).
+int build_path(AntGraph* g, int start, int end, int num_nodes, int* path, int* path_length, AntColony* colony);
+// Run a single iteration of the ACO algorithm (-1 if memory allocation fails).
 int run_iteration(AntGraph* g, AntColony* colony, int start, int end, int iteration, FILE* logfile);
+// Initialize a colony with default parameters for a graph of num_nodes nodes.
+int init_ant_colony(AntColony* colony, int num_nodes);
+// Free everything the colony owns (global best path and scratch buffers).
+void free_ant_colony(AntColony* colony);
+// Free the scratch buffers owned by the colony.
+void free_colony_workspace(AntColony* colony);
 
 #endif
@@ -3,6 +3,8 @@
 #include <stdlib.h>
 #include "ant_graph.h"
 #include "aco.h"
+#include "aco_solver.h"
+#include "graph_gen.h"
 
 
 /* Run ACO analysis with given parameters and print results */
@@ -20,7 +22,9 @@ void run_analysis(int num_nodes, double evap, double pher_w, double dist_w, int
         .alpha = pher_w, // pheromone weight
         .beta = dist_w, // distance/heuristic weight
         .evaporation_rate = evap, // evaporation rate
-        .deposit_amount = 1.0 // fixed pheromone deposit amount
+        .deposit_amount = 1.0, // fixed pheromone deposit amount
+        .console = stdout, // echo progress to the console
+        .convergence_csv = "convergence.csv" // record convergence data
     };
     // Start timing the run
     clock_t start = clock();
@@ -49,8 +53,8 @@ void run_analysis(int num_nodes, double evap, double pher_w, double dist_w, int
     clock_t end = clock();
     double runtime = (double)(end - start) / CLOCKS_PER_SEC;
     // Inspect pheromone levels on key edges
-    double shortcut_pher = g->edges[0][num_nodes-1].pheromone; // shortcut edge pheromone
-    double first_edge_pher = g->edges[0][1].pheromone; // first edge pheromone
+    double shortcut_pher = edge_pheromone(&g->edges[0][num_nodes-1]); // shortcut edge pheromone
+    double first_edge_pher = edge_pheromone(&g->edges[0][1]); // first edge pheromone
     // Print a single clean summary line of results
     if (convergence_iter == -1) {
         printf("Nodes=%d | Ants=%d | Evap=%.2f | PherW=%.2f | DistW=%.2f | Shortcut=%.2f | Edge01=%.2f | Runtime=%.3fs | ConvergenceIter=No\n",
@@ -61,10 +65,32 @@ void run_analysis(int num_nodes, double evap, double pher_w, double dist_w, int
             num_nodes, num_ants, evap, pher_w, dist_w,
             shortcut_pher, first_edge_pher, runtime, convergence_iter);
     }
-    // Free memory for the graph
+    // Free the colony and the graph
+    free_ant_colony(&colony);
     free_ant_graph(g);
 }
 
+/* Solve a generated graph from start to end and print one summary line */
+void run_scale_analysis(const char* name, AntGraph* g, double build_sec, int start, int end, int iterations, int num_ants,
+                        int bidirectional) {
+    AcoConfig config;
+    aco_default_config(&config);
+    config.num_ants = num_ants;
+    config.seed = 1;
+    config.bidirectional = bidirectional;
+    config.collect_stats = 1;
+    AcoSolver* solver = aco_solver_create(&config);
+    aco_solver_attach_graph(solver, g);
+    // Time only the solve, graph generation is reported separately
+    double t0 = aco_clock_seconds();
+    aco_solver_solve(solver, start, end, iterations);
+    double solve_sec = aco_clock_seconds() - t0;
+    printf("Graph=%s | Mode=%s | Nodes=%d | Edges=%d | Build=%.3fs | Solve=%.3fs | Steps=%lld | BestLength=%d | BestCost=%.2f\n",
+        name, bidirectional ? "bidirectional" : "forward", g->num_nodes, count_ant_graph_edges(g), build_sec,
+        solve_sec, aco_solver_stats(solver)->ant_steps, aco_solver_best_length(solver), aco_solver_best_cost(solver));
+    aco_solver_destroy(solver);
+}
+
 int main() {
     printf("ACO Analysis Results:\n");
     // Parameter sensitivity
@@ -79,6 +105,29 @@ int main() {
     run_analysis(20, 0.1, 1.0, 2.0, 20, 10);
     run_analysis(20, 0.1, 1.0, 2.0, 20, 20);
     run_analysis(20, 0.1, 1.0, 2.0, 20, 50);
-
+    // Scalability on generated topologies (corner to corner / node 0 to last node),
+    // each solved with forward-only and bidirectional path construction
+    const char* names[4] = {"grid", "geometric", "erdos-renyi", "barabasi-albert"};
+    for (int kind = 0; kind < 4; kind++) {
+        for (int bidirectional = 0; bidirectional <= 1; bidirectional++) {
+            double t0 = aco_clock_seconds();
+            AntGraph* graph = (kind == 0) ? generate_grid_graph(30, 30, 0.5, 1)
+                            : (kind == 1) ? generate_geometric_graph(1000, 0.06, 1)
+                            : (kind == 2) ? generate_erdos_renyi_graph(1000, 0.008, 1)
+                            : generate_barabasi_albert_graph(1000, 2, 1);
+            double build_sec = aco_clock_seconds() - t0;
+            run_scale_analysis(names[kind], graph, build_sec, 0, graph->num_nodes - 1, 10, 10, bidirectional);
+            free_ant_graph(graph);
+        }
+    }
+    // Long chain with one shortcut, the worst case for forward-only ants
+    for (int bidirectional = 0; bidirectional <= 1; bidirectional++) {
+        double t0 = aco_clock_seconds();
+        AntGraph* chain = create_ant_graph(500);
+        for (int i = 0; i < 499; i++) add_edge(chain, i, i + 1, 1.0);
+        add_edge(chain, 100, 400, 5.0);
+        run_scale_analysis("chain", chain, aco_clock_seconds() - t0, 0, 499, 10, 10, bidirectional);
+        free_ant_graph(chain);
+    }
     return 0;
 }
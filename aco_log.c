@@ -0,0 +1,426 @@
+// aco_log.c
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <sched.h>
+#include "aco_log.h"
+
+#define MIN_RING_CAPACITY 4096 // smallest ring buffer in bytes
+
+// Kinds of records carried by the ring buffer
+enum {
+    RECORD_ITERATION, // iteration header, no payload
+    RECORD_ANT_PATH, // ant path nodes
+    RECORD_ITERATION_BEST // AcoIterationSummary followed by best path nodes
+};
+
+// Fixed header in front of every record in the ring
+typedef struct {
+    int type; // One of the RECORD_* kinds
+    int id; // Iteration number or ant id
+    int length; // Number of path nodes stored after the payload
+} RecordHeader;
+
+// Background writer state
+struct AcoLogger {
+    unsigned char* ring; // Ring buffer of binary records
+    size_t capacity; // Ring size in bytes (power of two)
+    _Atomic size_t head; // Total bytes written by the producer
+    _Atomic size_t tail; // Total bytes consumed by the writer
+    _Atomic size_t flushed; // Tail position at the writer's last flush
+    _Atomic int stop; // Set to ask the writer to exit once the ring is empty
+    _Atomic int sleeping; // Set while the writer waits on wake
+    _Atomic long long dropped; // Records dropped because the ring was full (or out of memory)
+    AcoLogPolicy policy; // What to do when the ring is full
+
+    FILE* console; // Console stream (may be NULL)
+    FILE* logfile; // Logfile stream (may be NULL)
+    const char* csv_path; // Convergence CSV path (may be NULL)
+    FILE* csv; // CSV stream, opened by the writer on first use
+
+    int* nodes; // Writer-side buffer for decoded path nodes
+    int nodes_capacity; // Number of ints nodes can hold
+    pthread_mutex_t lock; // Guards the wake and drained condition variables
+    pthread_cond_t wake; // Signalled when a record is published or stop is set
+    pthread_cond_t drained; // Broadcast when the writer has flushed an empty ring
+    pthread_t thread; // Writer thread
+};
+
+
+/** Write a formatted message to the console and the logfile (either may be NULL).
+ * @param console Console stream, or NULL.
+ * @param logfile Logfile stream, or NULL.
+ * @param fmt printf-style format string.
+ */
+void write_both(FILE* console, FILE* logfile, const char* fmt, ...) {
+    va_list args;
+    if (console) {
+        va_start(args, fmt);
+        vfprintf(console, fmt, args);
+        va_end(args);
+    }
+    if (logfile) {
+        va_start(args, fmt);
+        vfprintf(logfile, fmt, args);
+        va_end(args);
+    }
+}
+
+
+/** Write the "Iteration N:" header.
+ * @param console Console stream, or NULL.
+ * @param logfile Logfile stream, or NULL.
+ * @param iteration Zero-based iteration number.
+ */
+void write_iteration_header(FILE* console, FILE* logfile, int iteration) {
+    write_both(console, logfile, "Iteration %d:\n", iteration + 1);
+}
+
+
+/** Write one ant's path.
+ * @param console Console stream, or NULL.
+ * @param logfile Logfile stream, or NULL.
+ * @param ant_id Identifier of the ant whose path is being logged.
+ * @param path Array containing the sequence of nodes visited.
+ * @param path_length Number of nodes in the path.
+ */
+void write_ant_path(FILE* console, FILE* logfile, int ant_id, const int* path, int path_length) {
+    // Print header with ant ID
+    write_both(console, logfile, "  Ant %d path:", ant_id);
+    // Print each node in the path
+    for (int i = 0; i < path_length; i++) {
+        write_both(console, logfile, " %d", path[i]);
+    }
+    write_both(console, logfile, "\n");
+}
+
+
+/** Write an iteration summary to the console/logfile and a row to the CSV.
+ * @param console Console stream, or NULL.
+ * @param logfile Logfile stream, or NULL.
+ * @param csv Convergence CSV stream, or NULL.
+ * @param summary Iteration best and global best figures.
+ * @param best_path Array containing the best path found this iteration.
+ */
+void write_iteration_best(FILE* console, FILE* logfile, FILE* csv, const AcoIterationSummary* summary, const int* best_path) {
+    // Log to console and logfile
+    write_both(console, logfile, "  Best path node count this iteration: %d\n", summary->best_length);
+    write_both(console, logfile, "  Best path weighted cost this iteration: %.2f\n", summary->best_cost);
+    write_both(console, logfile, "  Best path:");
+    // Print each node in the best path
+    for (int i = 0; i < summary->best_length; i++) {
+        write_both(console, logfile, " %d", best_path[i]);
+    }
+    write_both(console, logfile, "\n");
+    if (!csv) return;
+    // Log to CSV file
+    double chain_cost = 1.1 * (summary->num_nodes - 1); // expected cost of the chain path
+    double norm = summary->best_cost / chain_cost; // normalized cost
+    double improvement = chain_cost / summary->best_cost; // improvement factor this iteration
+    // Write a row with iteration data
+    fprintf(csv, "%d,%d,%.2f,%.4f,%d,%.2f,%.4f,%.2f,%.2f,%.2f,%.2f\n", summary->iteration + 1,
+        summary->best_length, summary->best_cost, norm, summary->global_best_length,
+        summary->global_best_cost, improvement, summary->alpha, summary->beta,
+        summary->evaporation_rate, summary->deposit_amount);
+}
+
+
+/** Write one decoded record to the logger's sinks.
+ * @param logger Pointer to the logger.
+ * @param header Record header.
+ * @param summary Iteration summary (used by RECORD_ITERATION_BEST only).
+ * @param nodes Path nodes (header->length of them).
+ */
+static void write_decoded(AcoLogger* logger, const RecordHeader* header, const AcoIterationSummary* summary,
+                          const int* nodes) {
+    switch (header->type) {
+        case RECORD_ITERATION:
+            write_iteration_header(logger->console, logger->logfile, header->id);
+            break;
+        case RECORD_ANT_PATH:
+            write_ant_path(logger->console, logger->logfile, header->id, nodes, header->length);
+            break;
+        case RECORD_ITERATION_BEST:
+            if (!logger->csv && logger->csv_path) logger->csv = fopen(logger->csv_path, "a");
+            write_iteration_best(logger->console, logger->logfile, logger->csv, summary, nodes);
+            break;
+    }
+}
+
+
+/** Flush every sink the logger writes to.
+ * @param logger Pointer to the logger.
+ */
+static void flush_sinks(AcoLogger* logger) {
+    if (logger->console) fflush(logger->console);
+    if (logger->logfile) fflush(logger->logfile);
+    if (logger->csv) fflush(logger->csv);
+}
+
+
+/** Copy bytes into the ring at a logical position, wrapping around the end.
+ * @param logger Pointer to the logger.
+ * @param pos Logical byte position (any value; reduced modulo capacity).
+ * @param src Bytes to copy.
+ * @param n Number of bytes.
+ */
+static void ring_put(AcoLogger* logger, size_t pos, const void* src, size_t n) {
+    size_t off = pos & (logger->capacity - 1);
+    size_t first = (n < logger->capacity - off) ? n : logger->capacity - off;
+    memcpy(logger->ring + off, src, first);
+    memcpy(logger->ring, (const unsigned char*)src + first, n - first);
+}
+
+
+/** Copy bytes out of the ring at a logical position, wrapping around the end.
+ * @param logger Pointer to the logger.
+ * @param pos Logical byte position.
+ * @param dst Destination buffer.
+ * @param n Number of bytes.
+ */
+static void ring_get(const AcoLogger* logger, size_t pos, void* dst, size_t n) {
+    size_t off = pos & (logger->capacity - 1);
+    size_t first = (n < logger->capacity - off) ? n : logger->capacity - off;
+    memcpy(dst, logger->ring + off, first);
+    memcpy((unsigned char*)dst + first, logger->ring, n - first);
+}
+
+
+/** Append one record to the ring (producer side).
+ * @param logger Pointer to the logger.
+ * @param header Record header (header->length nodes follow the payload).
+ * @param payload Fixed-size payload, or NULL.
+ * @param payload_size Size of the payload in bytes.
+ * @param nodes Path nodes to store after the payload.
+ * @param droppable Nonzero if the record may be dropped under ACO_LOG_DROP.
+ * @return 0 if queued (or written), -1 if dropped.
+ * A record larger than the whole ring is written synchronously once the
+ * writer has drained everything before it, unless it may be dropped.
+ */
+static int push_record(AcoLogger* logger, const RecordHeader* header, const void* payload, size_t payload_size,
+                       const int* nodes, int droppable) {
+    size_t nodes_size = (size_t)header->length * sizeof(int);
+    size_t size = sizeof(RecordHeader) + payload_size + nodes_size;
+    if (size > logger->capacity) { // can never fit in the ring
+        if (droppable && logger->policy == ACO_LOG_DROP) {
+            atomic_fetch_add(&logger->dropped, 1);
+            return -1;
+        }
+        aco_logger_flush(logger); // keep record order: the writer is idle once this returns
+        write_decoded(logger, header, payload, nodes);
+        flush_sinks(logger);
+        return 0;
+    }
+    size_t head = atomic_load_explicit(&logger->head, memory_order_relaxed);
+    // Wait (or drop) until the writer has freed enough space
+    while (logger->capacity - (head - atomic_load_explicit(&logger->tail, memory_order_acquire)) < size) {
+        if (droppable && logger->policy == ACO_LOG_DROP) {
+            atomic_fetch_add(&logger->dropped, 1);
+            return -1;
+        }
+        sched_yield();
+    }
+    ring_put(logger, head, header, sizeof(RecordHeader));
+    if (payload_size) ring_put(logger, head + sizeof(RecordHeader), payload, payload_size);
+    if (nodes_size) ring_put(logger, head + sizeof(RecordHeader) + payload_size, nodes, nodes_size);
+    atomic_store(&logger->head, head + size); // publish the record (seq_cst pairs with the sleeping check)
+    if (atomic_load(&logger->sleeping)) {
+        // The writer is waiting (or about to): the mutex orders this signal after its wait
+        pthread_mutex_lock(&logger->lock);
+        pthread_cond_signal(&logger->wake);
+        pthread_mutex_unlock(&logger->lock);
+    }
+    return 0;
+}
+
+
+/** Format and write the record at the given ring position (writer side).
+ * @param logger Pointer to the logger.
+ * @param pos Logical position of the record header.
+ * @return Size of the record in bytes.
+ * If the node buffer cannot grow, the record is skipped and counted as dropped.
+ */
+static size_t write_record(AcoLogger* logger, size_t pos) {
+    RecordHeader header;
+    AcoIterationSummary summary;
+    ring_get(logger, pos, &header, sizeof(header));
+    size_t payload_size = (header.type == RECORD_ITERATION_BEST) ? sizeof(summary) : 0;
+    size_t nodes_size = (size_t)header.length * sizeof(int);
+    size_t size = sizeof(header) + payload_size + nodes_size;
+    if (payload_size) ring_get(logger, pos + sizeof(header), &summary, payload_size);
+    // Grow the node buffer if this path is longer than any seen so far
+    if (header.length > logger->nodes_capacity) {
+        int* grown = realloc(logger->nodes, nodes_size);
+        if (!grown) { // out of memory: skip this record rather than stop logging
+            atomic_fetch_add(&logger->dropped, 1);
+            return size;
+        }
+        logger->nodes = grown;
+        logger->nodes_capacity = header.length;
+    }
+    if (nodes_size) ring_get(logger, pos + sizeof(header) + payload_size, logger->nodes, nodes_size);
+    write_decoded(logger, &header, &summary, logger->nodes);
+    return size;
+}
+
+
+/** Writer thread: drain the ring, flushing the sinks whenever it runs empty.
+ * Sleeps on the wake condition variable while there is nothing to write.
+ * @param arg Pointer to the logger.
+ * @return NULL.
+ */
+static void* writer_main(void* arg) {
+    AcoLogger* logger = arg;
+    for (;;) {
+        size_t tail = atomic_load_explicit(&logger->tail, memory_order_relaxed);
+        size_t head = atomic_load_explicit(&logger->head, memory_order_acquire);
+        if (tail == head) {
+            // Ring is empty: flush once, then exit or wait for more records
+            if (atomic_load_explicit(&logger->flushed, memory_order_relaxed) != tail) {
+                flush_sinks(logger);
+                atomic_store_explicit(&logger->flushed, tail, memory_order_release);
+                pthread_mutex_lock(&logger->lock);
+                pthread_cond_broadcast(&logger->drained);
+                pthread_mutex_unlock(&logger->lock);
+            }
+            // Stop is set after the last push, so re-reading head afterwards sees every record
+            if (atomic_load(&logger->stop) && atomic_load(&logger->head) == tail) break;
+            pthread_mutex_lock(&logger->lock);
+            atomic_store(&logger->sleeping, 1);
+            // Re-check after announcing the sleep so a record published meanwhile is not missed
+            while (atomic_load(&logger->head) == tail && !atomic_load(&logger->stop)) {
+                pthread_cond_wait(&logger->wake, &logger->lock);
+            }
+            atomic_store(&logger->sleeping, 0);
+            pthread_mutex_unlock(&logger->lock);
+            continue;
+        }
+        // Write every record that is already published
+        while (tail != head) {
+            tail += write_record(logger, tail);
+            atomic_store_explicit(&logger->tail, tail, memory_order_release); // free the space
+        }
+    }
+    return NULL;
+}
+
+
+/** Start a background writer.
+ * @param console Console stream, or NULL.
+ * @param logfile Logfile stream, or NULL.
+ * @param csv_path Convergence CSV path opened in append mode on first use, or NULL.
+ * @param capacity Ring buffer size in bytes (rounded up to a power of two).
+ * @param policy What the producer does when the ring is full.
+ * @return Pointer to the new logger, or NULL on failure.
+ */
+AcoLogger* aco_logger_create(FILE* console, FILE* logfile, const char* csv_path, size_t capacity, AcoLogPolicy policy) {
+    AcoLogger* logger = calloc(1, sizeof(AcoLogger));
+    if (!logger) return NULL;
+    // Round the ring up to a power of two so positions wrap with a mask
+    logger->capacity = MIN_RING_CAPACITY;
+    while (logger->capacity < capacity) logger->capacity *= 2;
+    logger->ring = malloc(logger->capacity);
+    if (!logger->ring) {
+        free(logger);
+        return NULL;
+    }
+    logger->policy = policy;
+    logger->console = console;
+    logger->logfile = logfile;
+    logger->csv_path = csv_path;
+    pthread_mutex_init(&logger->lock, NULL);
+    pthread_cond_init(&logger->wake, NULL);
+    pthread_cond_init(&logger->drained, NULL);
+    if (pthread_create(&logger->thread, NULL, writer_main, logger) != 0) {
+        pthread_cond_destroy(&logger->drained);
+        pthread_cond_destroy(&logger->wake);
+        pthread_mutex_destroy(&logger->lock);
+        free(logger->ring);
+        free(logger);
+        return NULL;
+    }
+    return logger;
+}
+
+
+/** Flush queued records, stop the writer thread and free the logger.
+ * @param logger Pointer to the logger (NULL is ignored).
+ */
+void aco_logger_destroy(AcoLogger* logger) {
+    if (!logger) return;
+    pthread_mutex_lock(&logger->lock);
+    atomic_store(&logger->stop, 1);
+    pthread_cond_signal(&logger->wake);
+    pthread_mutex_unlock(&logger->lock);
+    pthread_join(logger->thread, NULL); // writer drains the ring before exiting
+    pthread_cond_destroy(&logger->drained);
+    pthread_cond_destroy(&logger->wake);
+    pthread_mutex_destroy(&logger->lock);
+    if (logger->csv) fclose(logger->csv);
+    free(logger->nodes);
+    free(logger->ring);
+    free(logger);
+}
+
+
+/** Block until every record pushed so far has been written and flushed.
+ * Must be called from the producer thread.
+ * @param logger Pointer to the logger.
+ */
+void aco_logger_flush(AcoLogger* logger) {
+    size_t target = atomic_load_explicit(&logger->head, memory_order_relaxed);
+    pthread_mutex_lock(&logger->lock);
+    while (atomic_load_explicit(&logger->flushed, memory_order_acquire) != target) {
+        pthread_cond_wait(&logger->drained, &logger->lock);
+    }
+    pthread_mutex_unlock(&logger->lock);
+}
+
+
+/** Number of records dropped because the ring buffer was full, or because the
+ * writer could not allocate room to decode them.
+ * @param logger Pointer to the logger.
+ * @return Dropped record count.
+ */
+long long aco_logger_dropped(const AcoLogger* logger) {
+    return atomic_load(&((AcoLogger*)logger)->dropped);
+}
+
+
+/** Queue an iteration header record.
+ * @param logger Pointer to the logger.
+ * @param iteration Zero-based iteration number.
+ * @return 0 if queued, -1 if dropped.
+ */
+int aco_logger_push_iteration(AcoLogger* logger, int iteration) {
+    RecordHeader header = {RECORD_ITERATION, iteration, 0};
+    return push_record(logger, &header, NULL, 0, NULL, 0);
+}
+
+
+/** Queue an ant path record (dropped under ACO_LOG_DROP if the ring is full).
+ * @param logger Pointer to the logger.
+ * @param ant_id Identifier of the ant.
+ * @param path Array containing the sequence of nodes visited.
+ * @param path_length Number of nodes in the path.
+ * @return 0 if queued, -1 if dropped.
+ */
+int aco_logger_push_ant_path(AcoLogger* logger, int ant_id, const int* path, int path_length) {
+    RecordHeader header = {RECORD_ANT_PATH, ant_id, path_length};
+    return push_record(logger, &header, NULL, 0, path, 1);
+}
+
+
+/** Queue an iteration summary record.
+ * @param logger Pointer to the logger.
+ * @param summary Iteration best and global best figures.
+ * @param best_path Array containing the best path found this iteration.
+ * @return 0 if queued, -1 if dropped.
+ */
+int aco_logger_push_iteration_best(AcoLogger* logger, const AcoIterationSummary* summary, const int* best_path) {
+    RecordHeader header = {RECORD_ITERATION_BEST, summary->iteration, summary->best_length};
+    return push_record(logger, &header, summary, sizeof(*summary), best_path, 0);
+}
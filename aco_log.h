@@ -0,0 +1,56 @@
+// aco_log.h
+#ifndef ACO_LOG_H
+#define ACO_LOG_H
+
+#include <stdio.h>
+
+// Summary of one iteration's best path, as written to the log and the CSV
+typedef struct {
+    int iteration; // Zero-based iteration number
+    int best_length; // Node count of the iteration best path
+    double best_cost; // Weighted cost of the iteration best path
+    int global_best_length; // Node count of the global best path
+    double global_best_cost; // Weighted cost of the global best path
+    int num_nodes; // Number of nodes in the graph (for the chain baseline)
+    double alpha; // Colony parameters recorded in every CSV row
+    double beta;
+    double evaporation_rate;
+    double deposit_amount;
+} AcoIterationSummary;
+
+// What the producer does when the ring buffer is full
+typedef enum {
+    ACO_LOG_BLOCK, // wait for the writer thread to make room
+    ACO_LOG_DROP // drop ant path traces (iteration summaries still wait)
+} AcoLogPolicy;
+
+// Background writer fed by a lock-free single-producer ring buffer. Only one
+// thread (the solver) may push records; formatting and I/O run on the writer.
+// Records too large for the ring are written synchronously unless droppable.
+typedef struct AcoLogger AcoLogger;
+
+// Write a printf-style message to the console and logfile (either may be NULL).
+void write_both(FILE* console, FILE* logfile, const char* fmt, ...);
+// Write the "Iteration N:" header to the console and logfile (either may be NULL).
+void write_iteration_header(FILE* console, FILE* logfile, int iteration);
+// Write one ant's path to the console and logfile (either may be NULL).
+void write_ant_path(FILE* console, FILE* logfile, int ant_id, const int* path, int path_length);
+// Write an iteration summary to the console and logfile, and a row to csv (any may be NULL).
+void write_iteration_best(FILE* console, FILE* logfile, FILE* csv, const AcoIterationSummary* summary, const int* best_path);
+
+// Start a writer thread. csv_path is opened in append mode on first use (NULL disables it).
+AcoLogger* aco_logger_create(FILE* console, FILE* logfile, const char* csv_path, size_t capacity, AcoLogPolicy policy);
+// Flush queued records, stop the writer thread and free the logger.
+void aco_logger_destroy(AcoLogger* logger);
+// Block until every record pushed so far has been written and flushed.
+void aco_logger_flush(AcoLogger* logger);
+// Number of records dropped because the ring buffer was full or the writer ran out of memory.
+long long aco_logger_dropped(const AcoLogger* logger);
+// Queue an iteration header record.
+int aco_logger_push_iteration(AcoLogger* logger, int iteration);
+// Queue an ant path record.
+int aco_logger_push_ant_path(AcoLogger* logger, int ant_id, const int* path, int path_length);
+// Queue an iteration summary record.
+int aco_logger_push_iteration_best(AcoLogger* logger, const AcoIterationSummary* summary, const int* best_path);
+
+#endif
@@ -0,0 +1,39 @@
+// aco_rng.h
+#ifndef ACO_RNG_H
+#define ACO_RNG_H
+
+// Small reentrant random number generator (splitmix64). Each caller owns its
+// state, so independent solvers never share hidden global state like rand().
+// Any state value, including 0, is a valid seed.
+
+/** Advance the state and return the next 64 random bits.
+ * @param state Pointer to the generator state.
+ * @return Next pseudo-random 64-bit value.
+ */
+static inline unsigned long long aco_rng_next(unsigned long long* state) {
+    unsigned long long z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+
+/** Uniform random double in [0, 1).
+ * @param state Pointer to the generator state.
+ * @return Random value in [0, 1).
+ */
+static inline double aco_rng_uniform(unsigned long long* state) {
+    return (aco_rng_next(state) >> 11) * (1.0 / 9007199254740992.0); // 53 random bits
+}
+
+
+/** Uniform random integer in [0, n).
+ * @param state Pointer to the generator state.
+ * @param n Exclusive upper bound (must be positive).
+ * @return Random value in [0, n).
+ */
+static inline int aco_rng_below(unsigned long long* state, int n) {
+    return (int)(aco_rng_uniform(state) * n);
+}
+
+#endif
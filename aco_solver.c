@@ -0,0 +1,236 @@
+// aco_solver.c
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include "aco_solver.h"
+#include "aco.h"
+
+// Solver context: a colony, its private pheromone trails and the graph it works on
+struct AcoSolver {
+    AcoConfig config; // Parameters applied to the colony on each solve
+    AntColony colony; // Colony state (global best, workspace, random state)
+    const AntGraph* graph; // Attached graph (not owned, never written)
+    aco_pheromone_t* pheromone; // Private trails, graph->num_nodes^2 row-major
+    size_t pheromone_capacity; // Number of entries pheromone can hold
+    AcoStats stats; // Stats storage used when config.collect_stats is set
+};
+
+
+/** Fill a config with the default parameters.
+ * @param config Pointer to the config to fill.
+ */
+void aco_default_config(AcoConfig* config) {
+    *config = (AcoConfig){
+        .num_ants = 10,
+        .alpha = 1.0,
+        .beta = 2.0,
+        .evaporation_rate = 0.1,
+        .deposit_amount = 1.0,
+        .prevent_backtracking = 1,
+        .bidirectional = 0,
+        .seed = 0,
+        .collect_stats = 0
+    };
+}
+
+
+/** Create a solver.
+ * @param config Parameters to use, or NULL for the defaults.
+ * @return Pointer to the new solver, or NULL if the config is invalid or allocation fails.
+ */
+AcoSolver* aco_solver_create(const AcoConfig* config) {
+    AcoSolver* solver = calloc(1, sizeof(AcoSolver));
+    if (!solver) return NULL;
+    if (init_ant_colony(&solver->colony, 0) != 0) {
+        free(solver);
+        return NULL;
+    }
+    AcoConfig defaults;
+    aco_default_config(&defaults);
+    if (aco_solver_configure(solver, config ? config : &defaults) != 0) {
+        aco_solver_destroy(solver);
+        return NULL;
+    }
+    return solver;
+}
+
+
+/** Free a solver and everything it owns. The attached graph is not freed.
+ * @param solver Pointer to the solver (NULL is ignored).
+ */
+void aco_solver_destroy(AcoSolver* solver) {
+    if (!solver) return;
+    free_ant_colony(&solver->colony);
+    free(solver->pheromone);
+    free(solver);
+}
+
+
+/** Replace the solver's parameters.
+ * @param solver Pointer to the solver.
+ * @param config New parameters.
+ * @return 0 on success, -1 on invalid input.
+ */
+int aco_solver_configure(AcoSolver* solver, const AcoConfig* config) {
+    if (!solver || !config || config->num_ants <= 0) return -1;
+    solver->config = *config;
+    AntColony* colony = &solver->colony;
+    colony->num_ants = config->num_ants;
+    colony->alpha = config->alpha;
+    colony->beta = config->beta;
+    colony->evaporation_rate = config->evaporation_rate;
+    colony->deposit_amount = config->deposit_amount;
+    colony->prevent_backtracking = config->prevent_backtracking;
+    colony->bidirectional = config->bidirectional;
+    colony->rng_state = config->seed;
+    colony->stats = config->collect_stats ? &solver->stats : NULL;
+    return 0;
+}
+
+
+/** Attach the graph to solve on and size the private pheromone trails for it.
+ * Called through the aco_solver_attach_graph() macro, which passes the
+ * caller's storage mode so a program built in another mode is refused.
+ * @param solver Pointer to the solver.
+ * @param g Graph to attach (not owned and never written, so solvers may share it).
+ * @param precision ACO_PRECISION the caller was compiled with.
+ * @return 0 on success, -1 on invalid input, precision mismatch or allocation
+ *         failure (the old graph stays attached).
+ */
+int aco_solver_attach_graph_checked(AcoSolver* solver, const AntGraph* g, int precision) {
+    if (precision != ACO_PRECISION) return -1; // caller's Edge layout differs from ours
+    if (!solver || !g || g->num_nodes <= 0) return -1;
+    size_t entries = (size_t)g->num_nodes * g->num_nodes;
+    if (entries > solver->pheromone_capacity) {
+        aco_pheromone_t* grown = realloc(solver->pheromone, entries * sizeof(aco_pheromone_t));
+        if (!grown) return -1;
+        solver->pheromone = grown;
+        solver->pheromone_capacity = entries;
+    }
+    solver->graph = g;
+    solver->colony.global_best_length = INT_MAX; // old best belongs to another graph
+    return 0;
+}
+
+
+/** Run the colony on the attached graph with an optional deadline and callback.
+ * @param solver Pointer to the solver.
+ * @param start Index of the starting node.
+ * @param end Index of the target node.
+ * @param iterations Number of iterations to run.
+ * @param deadline aco_clock_seconds() time to stop at (0 for none).
+ * @param on_improve Callback fired when the best path improves, or NULL.
+ * @param user_data User pointer passed to on_improve.
+ * @return 1 if the deadline stopped the run, 0 if it finished, -1 on invalid input
+ *         or allocation failure.
+ */
+static int run_solver(AcoSolver* solver, int start, int end, int iterations, double deadline,
+                      AcoImproveCallback on_improve, void* user_data) {
+    if (!solver || !solver->graph || iterations < 0) return -1;
+    int n = solver->graph->num_nodes;
+    if (start < 0 || start >= n || end < 0 || end >= n) return -1;
+    AntColony* colony = &solver->colony;
+    // Every solve starts from the graph's initial trails and the configured seed,
+    // so the same query always gives the same answer
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) solver->pheromone[(size_t)i * n + j] = solver->graph->edges[i][j].pheromone;
+    }
+    colony->pheromone = solver->pheromone;
+    colony->rng_state = solver->config.seed;
+    if (colony->stats) reset_aco_stats(colony->stats);
+    colony->deadline = deadline;
+    colony->on_improve = on_improve;
+    colony->on_improve_data = user_data;
+    // The graph is only read: every pheromone update goes to colony->pheromone
+    int status = run_aco((AntGraph*)solver->graph, colony, start, end, iterations, NULL); // silent: no console, CSV or logfile
+    // Leave the colony without a deadline or callback for the next solve
+    colony->deadline = 0.0;
+    colony->on_improve = NULL;
+    colony->on_improve_data = NULL;
+    if (status != 0) return -1; // out of memory
+    return colony->deadline_hit ? 1 : 0;
+}
+
+
+/** Run the solver from start to end on the attached graph.
+ * @param solver Pointer to the solver.
+ * @param start Index of the starting node.
+ * @param end Index of the target node.
+ * @param iterations Number of iterations to run.
+ * @return 0 on success, -1 on invalid input, missing graph or allocation failure.
+ */
+int aco_solver_solve(AcoSolver* solver, int start, int end, int iterations) {
+    return run_solver(solver, start, end, iterations, 0.0, NULL, NULL);
+}
+
+
+/** Run the solver until an iteration cap or a wall-clock budget is reached.
+ * The deadline is checked before every ant, so the run overshoots the budget
+ * by at most one ant's path construction plus the iteration's logging.
+ * @param solver Pointer to the solver.
+ * @param start Index of the starting node.
+ * @param end Index of the target node.
+ * @param max_iterations Iteration cap (<= 0 runs until the deadline).
+ * @param budget_ms Wall-clock budget in milliseconds (<= 0 for no deadline).
+ * @param on_improve Callback fired when the best path improves, or NULL.
+ * @param user_data User pointer passed to on_improve.
+ * @return 1 if the deadline stopped the run, 0 if it finished, -1 on invalid input
+ *         or allocation failure.
+ */
+int aco_solver_solve_anytime(AcoSolver* solver, int start, int end, int max_iterations, double budget_ms,
+                             AcoImproveCallback on_improve, void* user_data) {
+    if (max_iterations <= 0 && budget_ms <= 0.0) return -1; // would never stop
+    double deadline = (budget_ms > 0.0) ? aco_clock_seconds() + budget_ms / 1000.0 : 0.0;
+    int iterations = (max_iterations > 0) ? max_iterations : INT_MAX;
+    return run_solver(solver, start, end, iterations, deadline, on_improve, user_data);
+}
+
+
+/** Number of nodes in the best path found.
+ * @param solver Pointer to the solver.
+ * @return Path length, or 0 if no path has been found.
+ */
+int aco_solver_best_length(const AcoSolver* solver) {
+    if (!solver || solver->colony.global_best_length == INT_MAX) return 0;
+    return solver->colony.global_best_length;
+}
+
+
+/** Copy the best path found.
+ * @param solver Pointer to the solver.
+ * @param out Array that receives the path nodes.
+ * @param capacity Number of ints out can hold; at most this many are copied.
+ * @return Full length of the best path (0 if none), which may exceed capacity.
+ */
+int aco_solver_best_path(const AcoSolver* solver, int* out, int capacity) {
+    int length = aco_solver_best_length(solver);
+    int copy_len = (length < capacity) ? length : capacity;
+    if (out && copy_len > 0) memcpy(out, solver->colony.global_best_path, copy_len * sizeof(int));
+    return length;
+}
+
+
+/** Total edge weight of the best path found.
+ * @param solver Pointer to the solver.
+ * @return Path cost, or -1 if no path has been found.
+ */
+double aco_solver_best_cost(const AcoSolver* solver) {
+    int length = aco_solver_best_length(solver);
+    if (length == 0) return -1.0;
+    double cost = 0.0;
+    const int* path = solver->colony.global_best_path;
+    // Sum the weights of each edge in the path
+    for (int i = 0; i < length - 1; i++) {
+        cost += solver->graph->edges[path[i]][path[i + 1]].weight;
+    }
+    return cost;
+}
+
+
+/** Stats collected by the last solve.
+ * @param solver Pointer to the solver.
+ * @return Pointer to the stats, or NULL if collect_stats is not set.
+ */
+const AcoStats* aco_solver_stats(const AcoSolver* solver) {
+    return solver ? solver->colony.stats : NULL;
+}
@@ -0,0 +1,62 @@
+// aco_solver.h
+#ifndef ACO_SOLVER_H
+#define ACO_SOLVER_H
+
+#include "ant_graph.h"
+#include "aco_stats.h"
+#include "aco_types.h"
+
+// Opaque solver context. Each context owns its colony, random state, pheromone
+// trails and buffers, so independent contexts can run concurrently on different
+// threads, sharing one read-only graph. A context never prints or opens files.
+// Every solve starts from the graph's initial pheromone and the configured seed,
+// so the same inputs always give the same result.
+typedef struct AcoSolver AcoSolver;
+
+// Tunable parameters of a solver
+typedef struct {
+    int num_ants; // Number of ants per iteration
+    double alpha; // Influence of pheromone trails
+    double beta; // Influence of heuristic (edge length)
+    double evaporation_rate; // Rate pheromone trails fade
+    double deposit_amount; // Amount of pheromone deposited on best paths
+    int prevent_backtracking; // Flag to prevent ants from immediately returning to previous node
+    int bidirectional; // Flag to build paths from both ends and join them in the middle
+    unsigned long long seed; // Seed for the solver's private random generator
+    int collect_stats; // Flag to collect counters and phase timers
+} AcoConfig;
+
+// Fill a config with the default parameters.
+void aco_default_config(AcoConfig* config);
+// Create a solver (NULL config uses the defaults). Returns NULL if the config is
+// invalid (see aco_solver_configure) or allocation fails.
+AcoSolver* aco_solver_create(const AcoConfig* config);
+// Free a solver. The attached graph is not freed.
+void aco_solver_destroy(AcoSolver* solver);
+// Replace the solver's parameters (resets the random state to the new seed).
+// Returns 0 on success, -1 if num_ants <= 0.
+int aco_solver_configure(AcoSolver* solver, const AcoConfig* config);
+// Attach the graph to solve on. The graph is never written, so any number of
+// solvers may share it. Allocates num_nodes^2 private pheromone entries.
+// Returns 0 on success, -1 on invalid input, out of memory, or if the program
+// was built with a different pheromone storage mode than the library.
+#define aco_solver_attach_graph(solver, g) aco_solver_attach_graph_checked((solver), (g), ACO_PRECISION)
+int aco_solver_attach_graph_checked(AcoSolver* solver, const AntGraph* g, int precision);
+// Run the solver from start to end. Returns 0 on success, -1 on invalid input or out of memory.
+int aco_solver_solve(AcoSolver* solver, int start, int end, int iterations);
+// Anytime solve: run until max_iterations (<= 0 for no cap) or until budget_ms of
+// wall-clock time has passed, whichever comes first. on_improve (may be NULL) fires
+// each time the best path improves. Returns 1 if the deadline cut the run short,
+// 0 if it finished, -1 on invalid input or out of memory. The best path so far is kept either way.
+int aco_solver_solve_anytime(AcoSolver* solver, int start, int end, int max_iterations, double budget_ms,
+                             AcoImproveCallback on_improve, void* user_data);
+// Number of nodes in the best path found (0 if none).
+int aco_solver_best_length(const AcoSolver* solver);
+// Copy up to capacity nodes of the best path into out. Returns the full path length.
+int aco_solver_best_path(const AcoSolver* solver, int* out, int capacity);
+// Total edge weight of the best path (-1 if none).
+double aco_solver_best_cost(const AcoSolver* solver);
+// Stats collected by the last solve (NULL unless collect_stats is set).
+const AcoStats* aco_solver_stats(const AcoSolver* solver);
+
+#endif
@@ -0,0 +1,85 @@
+// aco_stats.c
+#include <stdio.h>
+#include <time.h>
+#include <sys/resource.h>
+#include "aco_stats.h"
+
+
+/** Current monotonic wall-clock time.
+ * @return Seconds since an arbitrary fixed point (only differences are meaningful).
+ */
+double aco_clock_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+
+/** Measure the peak resident set size of the process.
+ * @return Peak RSS in KB, or 0 if the OS does not report it.
+ */
+long measure_peak_rss_kb(void) {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+    return usage.ru_maxrss; // reported in KB on Linux
+}
+
+
+/** Zero every counter and timer.
+ * @param stats Pointer to the stats to reset. The json_out stream is kept.
+ */
+void reset_aco_stats(AcoStats* stats) {
+    FILE* json_out = stats->json_out; // keep the output stream across resets
+    *stats = (AcoStats){0};
+    stats->json_out = json_out;
+}
+
+
+/** Name of a phase as used in reports.
+ * @param phase Phase to name.
+ * @return Static lowercase name of the phase.
+ */
+const char* aco_phase_name(AcoPhase phase) {
+    switch (phase) {
+        case ACO_PHASE_CONSTRUCTION: return "construction";
+        case ACO_PHASE_DEPOSIT: return "deposit";
+        case ACO_PHASE_EVAPORATION: return "evaporation";
+        case ACO_PHASE_LOGGING: return "logging";
+        default: return "unknown";
+    }
+}
+
+
+/** Write the stats as a single JSON object followed by a newline.
+ * @param stats Pointer to the stats to write.
+ * @param out Stream to write into.
+ */
+void write_aco_stats_json(const AcoStats* stats, FILE* out) {
+    fprintf(out, "{\"iteration\":%d,\"ant_steps\":%lld,\"dead_ends\":%lld,\"exploration_picks\":%lld,"
+        "\"roulette_fallthroughs\":%lld,\"allocations\":%lld,\"phase_seconds\":{", stats->iterations,
+        stats->ant_steps, stats->dead_ends, stats->exploration_picks, stats->roulette_fallthroughs,
+        stats->allocations);
+    // One entry per timed phase
+    for (int p = 0; p < ACO_PHASE_COUNT; p++) {
+        fprintf(out, "%s\"%s\":%.6f", p ? "," : "", aco_phase_name(p), stats->phase_seconds[p]);
+    }
+    fprintf(out, "},\"peak_rss_kb\":%ld}\n", stats->peak_rss_kb);
+}
+
+
+/** Print a human-readable summary of the stats.
+ * @param stats Pointer to the stats to print.
+ * @param out Stream to write into.
+ */
+void print_aco_stats(const AcoStats* stats, FILE* out) {
+    fprintf(out, "Ant steps: %lld\n", stats->ant_steps);
+    fprintf(out, "Dead-end aborts: %lld\n", stats->dead_ends);
+    fprintf(out, "Exploration picks: %lld\n", stats->exploration_picks);
+    fprintf(out, "Roulette fall-throughs: %lld\n", stats->roulette_fallthroughs);
+    fprintf(out, "Allocations: %lld\n", stats->allocations);
+    // Time spent in each phase
+    for (int p = 0; p < ACO_PHASE_COUNT; p++) {
+        fprintf(out, "Phase %s: %.3f seconds\n", aco_phase_name(p), stats->phase_seconds[p]);
+    }
+    fprintf(out, "Peak memory (RSS): %.2f MB\n", stats->peak_rss_kb / 1024.0);
+}
@@ -0,0 +1,43 @@
+// aco_stats.h
+#ifndef ACO_STATS_H
+#define ACO_STATS_H
+
+#include <stdio.h>
+
+// Phases of an iteration that are timed separately
+typedef enum {
+    ACO_PHASE_CONSTRUCTION, // ants building paths
+    ACO_PHASE_DEPOSIT, // pheromone deposit on iteration/global best
+    ACO_PHASE_EVAPORATION, // pheromone evaporation over all edges
+    ACO_PHASE_LOGGING, // console, logfile and CSV output
+    ACO_PHASE_COUNT // number of phases (not a phase)
+} AcoPhase;
+
+// Hot-path counters and phase timers collected while the colony runs
+typedef struct {
+    long long ant_steps; // Moves made by all ants
+    long long dead_ends; // Ants aborted because no valid move was left
+    long long exploration_picks; // Moves chosen by random exploration
+    long long roulette_fallthroughs; // Roulette wheel misses resolved by highest appeal
+    long long allocations; // Heap allocations made by the solver
+    double phase_seconds[ACO_PHASE_COUNT]; // Wall-clock time spent in each phase
+    long peak_rss_kb; // Peak resident set size of the process (KB)
+    int iterations; // Iterations completed since the last reset
+
+    FILE* json_out; // Optional stream that receives one JSON line per iteration
+} AcoStats;
+
+// Current monotonic wall-clock time in seconds.
+double aco_clock_seconds(void);
+// Peak resident set size of the process in KB (0 if unavailable).
+long measure_peak_rss_kb(void);
+// Zero every counter and timer (json_out is kept).
+void reset_aco_stats(AcoStats* stats);
+// Name of a phase as used in reports.
+const char* aco_phase_name(AcoPhase phase);
+// Write the stats as a single JSON object line.
+void write_aco_stats_json(const AcoStats* stats, FILE* out);
+// Print a human-readable summary of the stats.
+void print_aco_stats(const AcoStats* stats, FILE* out);
+
+#endif
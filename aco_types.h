@@ -0,0 +1,10 @@
+// aco_types.h
+#ifndef ACO_TYPES_H
+#define ACO_TYPES_H
+
+// Types shared by the colony (aco.h) and the opaque solver API (aco_solver.h)
+
+// Called whenever the global best path improves (path is only valid during the call)
+typedef void (*AcoImproveCallback)(const int* path, int path_length, double cost, int iteration, void* user_data);
+
+#endif
@@ -3,28 +3,44 @@
 #include "ant_graph.h"
 
 
+/** Storage mode this library was built with.
+ * @return One of ACO_PRECISION_DOUBLE, ACO_PRECISION_FLOAT or ACO_PRECISION_Q16.
+ */
+int ant_graph_precision(void) {
+    return ACO_PRECISION;
+}
+
+
 /** Create a new graph with n nodes
  * @param n Number of nodes
- * @return Pointer to the newly created AntGraph
+ * @return Pointer to the newly created AntGraph, or NULL if n is negative or allocation fails
  * Allocates memory for the graph structure and its adjacency matrix.
  */
 AntGraph* create_ant_graph(int n) {
+    if (n < 0) return NULL;
     AntGraph* g = malloc(sizeof(AntGraph)); // allocate memory for the graph structure
-    if (!g) { fprintf(stderr, "Allocation failed\n"); exit(1); }
-    g->num_nodes = n; // set the number of nodes
-    
+    if (!g) return NULL;
+    g->num_nodes = 0; // counts allocated rows until the matrix is complete
+
     // allocate memory for n rows (each row is an array of Edge structs)
-    g->edges = malloc(n * sizeof(Edge*));
-    if (!g->edges) { fprintf(stderr, "Allocation failed\n"); exit(1); }
+    g->edges = malloc((n > 0 ? n : 1) * sizeof(Edge*));
+    if (!g->edges) {
+        free(g);
+        return NULL;
+    }
 
     for (int i = 0; i < n; i++) {
         g->edges[i] = malloc(n * sizeof(Edge)); // allocate n Edge structs for this row
-        if (!g->edges[i]) { fprintf(stderr, "Allocation failed\n"); exit(1); }
+        if (!g->edges[i]) {
+            free_ant_graph(g); // frees the rows allocated so far
+            return NULL;
+        }
+        g->num_nodes = i + 1;
 
         // initialize each edge in the row
         for (int j = 0; j < n; j++) {
             g->edges[i][j].weight = 0.0; // default weight, no edge yet
-            g->edges[i][j].pheromone = 1.0; // baseline pheromone level
+            set_edge_pheromone(&g->edges[i][j], 1.0); // baseline pheromone level
             g->edges[i][j].exists = 0; // edge does not exist
         }
     }
@@ -33,11 +49,12 @@ AntGraph* create_ant_graph(int n) {
 
 
 /** Free the memory used by the graph
- *  @param g Pointer to the AntGraph to be freed
+ *  @param g Pointer to the AntGraph to be freed (NULL is ignored)
  *  Frees each row of the adjacency matrix, then the row pointer array,
  *  and finally the graph structure itself.
  */
 void free_ant_graph(AntGraph* g) {
+    if (!g) return;
     for (int i = 0; i < g->num_nodes; i++) {
         free(g->edges[i]); // free each row of the adjacency matrix
     }
@@ -51,23 +68,39 @@ void free_ant_graph(AntGraph* g) {
  * @param from Source node index
  * @param to Destination node index
  * @param weight Weight of the edge
+ * @return 0 on success, -1 if either index is out of range (the graph is unchanged)
  * Updates both directions of the adjacency matrix since the graph is undirected.
  */
-void add_edge(AntGraph* g, int from, int to, double weight) {
+int add_edge(AntGraph* g, int from, int to, double weight) {
     // validate indices: ensure they are within bounds
     if (from < 0 || from >= g->num_nodes || to < 0 || to >= g->num_nodes) {
-        printf("You shall not pass! Invalid edge (%d, %d). Valid range: 0 to %d.\n",
-               from, to, g->num_nodes - 1);
-        return;
+        return -1; // you shall not pass
     }
     // set edge fields for both directions (undirected graph)
     g->edges[from][to].weight = weight;
-    g->edges[from][to].pheromone = 1.0; // reset pheromone to baseline
+    set_edge_pheromone(&g->edges[from][to], 1.0); // reset pheromone to baseline
     g->edges[from][to].exists = 1; // mark edge as existing
 
     g->edges[to][from].weight = weight;
-    g->edges[to][from].pheromone = 1.0; // reset pheromone to baseline
+    set_edge_pheromone(&g->edges[to][from], 1.0); // reset pheromone to baseline
     g->edges[to][from].exists = 1; // mark edge as existing
+    return 0;
+}
+
+
+/** Count the undirected edges in the graph
+ * @param g Pointer to the AntGraph (const since not modifying it)
+ * @return Number of edges, each undirected edge counted once
+ */
+int count_ant_graph_edges(const AntGraph* g) {
+    int count = 0;
+    // scan the upper triangle so each edge is seen once
+    for (int i = 0; i < g->num_nodes; i++) {
+        for (int j = i + 1; j < g->num_nodes; j++) {
+            if (g->edges[i][j].exists) count++;
+        }
+    }
+    return count;
 }
 
 
@@ -84,7 +117,7 @@ void print_ant_graph(const AntGraph* g) {
         for (int j = 0; j < g->num_nodes; j++) {
             if (g->edges[i][j].exists) {
                 // print edge weight and pheromone if edge exists
-                printf("%.1f|%.1f ", g->edges[i][j].weight, g->edges[i][j].pheromone);
+                printf("%.1f|%.1f ", (double)g->edges[i][j].weight, edge_pheromone(&g->edges[i][j]));
             } else {
                 // print placeholder if no edge
                 printf(" . | .  ");
@@ -1,14 +1,92 @@
 #ifndef ANT_GRAPH_H
 #define ANT_GRAPH_H
 
+#include <math.h>
+
+// Edge storage precision, chosen at compile time:
+//   default               double weight and pheromone (24-byte Edge)
+//   -DACO_PHEROMONE_FLOAT float weight and pheromone (12-byte Edge)
+//   -DACO_PHEROMONE_Q16   float weight, 16-bit log-scaled pheromone (8-byte Edge)
+// Always read and write pheromone through edge_pheromone()/set_edge_pheromone().
+// The library and every program using it must be built in the same mode (the
+// Makefile's PRECISION variable); ant_graph_precision() reports the library's.
+#define ACO_PRECISION_DOUBLE 0
+#define ACO_PRECISION_FLOAT 1
+#define ACO_PRECISION_Q16 2
+#if defined(ACO_PHEROMONE_Q16)
+#define ACO_PRECISION ACO_PRECISION_Q16
+typedef float aco_weight_t;
+typedef unsigned short aco_pheromone_t;
+typedef unsigned short aco_flag_t;
+#elif defined(ACO_PHEROMONE_FLOAT)
+#define ACO_PRECISION ACO_PRECISION_FLOAT
+typedef float aco_weight_t;
+typedef float aco_pheromone_t;
+typedef int aco_flag_t;
+#else
+#define ACO_PRECISION ACO_PRECISION_DOUBLE
+typedef double aco_weight_t;
+typedef double aco_pheromone_t;
+typedef int aco_flag_t;
+#endif
+
+// 16-bit pheromone codes map log-linearly onto [1e-3, 1e3] (relative step ~2e-4)
+#define PHEROMONE_Q16_LOG_MIN (-6.907755278982137) // ln(1e-3)
+#define PHEROMONE_Q16_SCALE (65535.0 / 13.815510557964274) // codes per unit of ln(level)
+
 // Structure representing a single edge in the graph
 typedef struct Edge {
-    double weight;      // Weight (distance) of the edge
-    double pheromone;   // Pheromone level on the edge
-    int exists;         // Boolean flag indicating if the edge exists (1 = yes, 0 = no)
+    aco_weight_t weight;       // Weight (distance) of the edge
+    aco_pheromone_t pheromone; // Stored pheromone level (use edge_pheromone() to read)
+    aco_flag_t exists;         // Boolean flag indicating if the edge exists (1 = yes, 0 = no)
 } Edge;
 
 
+/** Decode a stored pheromone value.
+ * @param stored Value in the storage format.
+ * @return Pheromone level.
+ */
+static inline double pheromone_decode(aco_pheromone_t stored) {
+#if defined(ACO_PHEROMONE_Q16)
+    return exp(PHEROMONE_Q16_LOG_MIN + stored / PHEROMONE_Q16_SCALE);
+#else
+    return stored;
+#endif
+}
+
+
+/** Encode a pheromone level into the storage format.
+ * @param level Pheromone level (clamped to [1e-3, 1e3] in 16-bit mode).
+ * @return Value in the storage format.
+ */
+static inline aco_pheromone_t pheromone_encode(double level) {
+#if defined(ACO_PHEROMONE_Q16)
+    double q = (log(level) - PHEROMONE_Q16_LOG_MIN) * PHEROMONE_Q16_SCALE;
+    return (q <= 0.0) ? 0 : (q >= 65535.0) ? 65535 : (aco_pheromone_t)(q + 0.5);
+#else
+    return (aco_pheromone_t)level;
+#endif
+}
+
+
+/** Read the pheromone level of an edge.
+ * @param e Pointer to the edge.
+ * @return Pheromone level decoded from the storage format.
+ */
+static inline double edge_pheromone(const Edge* e) {
+    return pheromone_decode(e->pheromone);
+}
+
+
+/** Store a pheromone level on an edge.
+ * @param e Pointer to the edge.
+ * @param level Pheromone level (clamped to [1e-3, 1e3] in 16-bit mode).
+ */
+static inline void set_edge_pheromone(Edge* e, double level) {
+    e->pheromone = pheromone_encode(level);
+}
+
+
 // Structure representing a graph for the Ant Colony Optimization algorithm
 typedef struct AntGraph {
     int num_nodes; // Number of nodes in the graph
@@ -16,14 +94,21 @@ typedef struct AntGraph {
 } AntGraph;
 
 
-// Create a new graph with n nodes
+// Storage mode the library was built with (one of ACO_PRECISION_*). A program
+// built in another mode sees a different Edge layout: compare with ACO_PRECISION.
+int ant_graph_precision(void);
+
+// Create a new graph with n nodes (NULL if allocation fails)
 AntGraph* create_ant_graph(int n);
 
 // Free the memory used by the graph
 void free_ant_graph(AntGraph* graph);
 
-// Add an edge with a specified weight between two nodes
-void add_edge(AntGraph* graph, int from, int to, double weight);
+// Add an edge with a specified weight between two nodes (-1 if an index is invalid)
+int add_edge(AntGraph* graph, int from, int to, double weight);
+
+// Count the undirected edges in the graph
+int count_ant_graph_edges(const AntGraph* g);
 
 // Print the adjacency matrix of the graph
 void print_ant_graph(const AntGraph* g);
@@ -0,0 +1,210 @@
+// graph_gen.c
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <math.h>
+#include "graph_gen.h"
+#include "aco_rng.h"
+
+#define MIN_EDGE_WEIGHT 1e-6 // keeps the 1/weight heuristic finite
+
+
+/** Set an undirected edge without bounds checks (indices must be valid).
+ * @param g Pointer to the AntGraph.
+ * @param u First node index.
+ * @param v Second node index.
+ * @param weight Weight of the edge.
+ */
+static inline void set_edge(AntGraph* g, int u, int v, double weight) {
+    Edge* e = &g->edges[u][v];
+    e->weight = weight;
+    set_edge_pheromone(e, 1.0); // baseline pheromone level
+    e->exists = 1;
+    g->edges[v][u] = *e; // mirror for the undirected graph
+}
+
+
+/** Random weight uniform in [1, 10).
+ * @param rng Pointer to the generator state.
+ * @return Edge weight.
+ */
+static inline double random_weight(unsigned long long* rng) {
+    return 1.0 + 9.0 * aco_rng_uniform(rng);
+}
+
+
+/** Generate a 2D road-like grid.
+ * Node (r, c) has index r * cols + c and is joined to its right and lower neighbors.
+ * @param rows Number of grid rows.
+ * @param cols Number of grid columns.
+ * @param jitter Maximum extra weight added to the base weight of 1.0.
+ * @param seed Seed for the weight noise.
+ * @return Pointer to the new graph, or NULL on invalid input or allocation failure.
+ */
+AntGraph* generate_grid_graph(int rows, int cols, double jitter, unsigned long long seed) {
+    if (rows <= 0 || cols <= 0 || rows > INT_MAX / cols) return NULL; // node count must fit in an int
+    AntGraph* g = create_ant_graph(rows * cols);
+    if (!g) return NULL;
+    unsigned long long rng = seed;
+    for (int r = 0; r < rows; r++) {
+        for (int c = 0; c < cols; c++) {
+            int u = r * cols + c;
+            if (c + 1 < cols) set_edge(g, u, u + 1, 1.0 + jitter * aco_rng_uniform(&rng)); // right
+            if (r + 1 < rows) set_edge(g, u, u + cols, 1.0 + jitter * aco_rng_uniform(&rng)); // down
+        }
+    }
+    return g;
+}
+
+
+/** Generate a random geometric graph.
+ * Points are bucketed into cells of side radius (counting sort), so each
+ * point only compares against points in its own and neighboring cells.
+ * @param n Number of nodes.
+ * @param radius Connection radius in the unit square.
+ * @param seed Seed for the point positions.
+ * @return Pointer to the new graph, or NULL on invalid input or allocation failure.
+ */
+AntGraph* generate_geometric_graph(int n, double radius, unsigned long long seed) {
+    if (n <= 0 || radius <= 0.0) return NULL;
+    int cells = (int)(1.0 / radius); // cells per side (each at least radius wide)
+    if (cells < 1) cells = 1;
+    int max_cells = (int)sqrt((double)n) + 1; // about one point per cell is enough
+    if (cells > max_cells) cells = max_cells;
+    double* x = malloc(n * sizeof(double));
+    double* y = malloc(n * sizeof(double));
+    int* cell_of = malloc(n * sizeof(int));
+    int* cell_start = calloc((size_t)cells * cells + 1, sizeof(int));
+    int* order = malloc(n * sizeof(int));
+    if (!x || !y || !cell_of || !cell_start || !order) {
+        free(x); free(y); free(cell_of); free(cell_start); free(order);
+        return NULL;
+    }
+    // Place points and count how many fall in each cell
+    unsigned long long rng = seed;
+    for (int i = 0; i < n; i++) {
+        x[i] = aco_rng_uniform(&rng);
+        y[i] = aco_rng_uniform(&rng);
+        int cx = (int)(x[i] * cells), cy = (int)(y[i] * cells);
+        cell_of[i] = cy * cells + cx;
+        cell_start[cell_of[i] + 1]++;
+    }
+    // Prefix sums give each cell's slice of the order array
+    for (int c = 0; c < cells * cells; c++) cell_start[c + 1] += cell_start[c];
+    int* fill = malloc((size_t)cells * cells * sizeof(int));
+    if (!fill) {
+        free(x); free(y); free(cell_of); free(cell_start); free(order);
+        return NULL;
+    }
+    for (int c = 0; c < cells * cells; c++) fill[c] = cell_start[c];
+    for (int i = 0; i < n; i++) order[fill[cell_of[i]]++] = i;
+    free(fill);
+
+    AntGraph* g = create_ant_graph(n);
+    if (!g) {
+        free(x); free(y); free(cell_of); free(cell_start); free(order);
+        return NULL;
+    }
+    double r2 = radius * radius;
+    for (int i = 0; i < n; i++) {
+        int cx = cell_of[i] % cells, cy = cell_of[i] / cells;
+        // Compare against points in the 3x3 block of cells around i
+        for (int dy = -1; dy <= 1; dy++) {
+            for (int dx = -1; dx <= 1; dx++) {
+                int nx = cx + dx, ny = cy + dy;
+                if (nx < 0 || ny < 0 || nx >= cells || ny >= cells) continue;
+                int c = ny * cells + nx;
+                for (int k = cell_start[c]; k < cell_start[c + 1]; k++) {
+                    int j = order[k];
+                    if (j <= i) continue; // each pair once
+                    double ddx = x[i] - x[j], ddy = y[i] - y[j];
+                    double d2 = ddx * ddx + ddy * ddy;
+                    if (d2 > r2) continue;
+                    double w = sqrt(d2) / radius;
+                    set_edge(g, i, j, w > MIN_EDGE_WEIGHT ? w : MIN_EDGE_WEIGHT);
+                }
+            }
+        }
+    }
+    free(x); free(y); free(cell_of); free(cell_start); free(order);
+    return g;
+}
+
+
+/** Generate an Erdos-Renyi G(n, p) graph.
+ * Uses geometric skipping over the candidate pairs (Batagelj-Brandes), so
+ * the cost is proportional to the number of edges produced, not n^2.
+ * @param n Number of nodes.
+ * @param p Probability that each pair of nodes is joined.
+ * @param seed Seed for edge selection and weights.
+ * @return Pointer to the new graph, or NULL on invalid input or allocation failure.
+ */
+AntGraph* generate_erdos_renyi_graph(int n, double p, unsigned long long seed) {
+    if (n <= 0 || p < 0.0) return NULL;
+    AntGraph* g = create_ant_graph(n);
+    if (!g || p == 0.0) return g;
+    unsigned long long rng = seed;
+    if (p >= 1.0) { // complete graph, nothing to skip
+        for (int v = 1; v < n; v++)
+            for (int w = 0; w < v; w++) set_edge(g, v, w, random_weight(&rng));
+        return g;
+    }
+    double log_q = log(1.0 - p);
+    long long v = 1, w = -1; // walk the pairs (v, w) with w < v in row-major order
+    while (v < n) {
+        double r = aco_rng_uniform(&rng);
+        w += 1 + (long long)floor(log(1.0 - r) / log_q); // skip pairs that are not edges
+        while (w >= v && v < n) {
+            w -= v;
+            v++;
+        }
+        if (v < n) set_edge(g, (int)v, (int)w, random_weight(&rng));
+    }
+    return g;
+}
+
+
+/** Generate a Barabasi-Albert scale-free graph.
+ * Starts from a clique of m + 1 nodes. Every endpoint of every edge is kept
+ * in a list, so a uniform pick from the list is a degree-proportional pick.
+ * @param n Number of nodes.
+ * @param m Edges added per new node (1 <= m < n).
+ * @param seed Seed for attachment and weights.
+ * @return Pointer to the new graph, or NULL on invalid input or allocation failure.
+ */
+AntGraph* generate_barabasi_albert_graph(int n, int m, unsigned long long seed) {
+    if (m < 1 || n <= m) return NULL;
+    long long total_edges = (long long)m * (m + 1) / 2 + (long long)(n - m - 1) * m;
+    int* endpoints = malloc(2 * total_edges * sizeof(int));
+    if (!endpoints) return NULL;
+    long long count = 0; // number of endpoints recorded so far
+
+    AntGraph* g = create_ant_graph(n);
+    if (!g) {
+        free(endpoints);
+        return NULL;
+    }
+    unsigned long long rng = seed;
+    // Seed clique of m + 1 nodes
+    for (int v = 0; v <= m; v++) {
+        for (int w = 0; w < v; w++) {
+            set_edge(g, v, w, random_weight(&rng));
+            endpoints[count++] = v;
+            endpoints[count++] = w;
+        }
+    }
+    // Attach each new node to m distinct existing nodes
+    for (int v = m + 1; v < n; v++) {
+        long long existing = count; // only pick from endpoints that predate v
+        for (int added = 0; added < m; ) {
+            int w = endpoints[(long long)(aco_rng_uniform(&rng) * existing)];
+            if (g->edges[v][w].exists) continue; // already linked, pick again
+            set_edge(g, v, w, random_weight(&rng));
+            endpoints[count++] = v;
+            endpoints[count++] = w;
+            added++;
+        }
+    }
+    free(endpoints);
+    return g;
+}
@@ -0,0 +1,24 @@
+// graph_gen.h
+#ifndef GRAPH_GEN_H
+#define GRAPH_GEN_H
+
+#include "ant_graph.h"
+
+// Seeded synthetic graph generators for scale testing. Edges are written
+// straight into the adjacency matrix (no per-call add_edge checks) and are
+// generated in O(n + m) time on top of the O(n^2) matrix allocation.
+// The same seed always produces the same graph. Each returns NULL on invalid
+// input or if the graph cannot be allocated.
+
+// 2D road-like grid of rows x cols nodes; weights are 1.0 plus up to jitter of noise.
+AntGraph* generate_grid_graph(int rows, int cols, double jitter, unsigned long long seed);
+// Random geometric graph: n points in the unit square joined when closer than radius.
+// Weights are distance / radius, so they fall in (0, 1].
+AntGraph* generate_geometric_graph(int n, double radius, unsigned long long seed);
+// Erdos-Renyi G(n, p) graph with weights uniform in [1, 10).
+AntGraph* generate_erdos_renyi_graph(int n, double p, unsigned long long seed);
+// Barabasi-Albert scale-free graph: each new node attaches to m existing nodes
+// chosen proportionally to degree. Weights are uniform in [1, 10).
+AntGraph* generate_barabasi_albert_graph(int n, int m, unsigned long long seed);
+
+#endif
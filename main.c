@@ -2,7 +2,6 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <limits.h>
-#include <time.h>
 #include "ant_graph.h"
 #include "aco.h"
 
@@ -20,11 +19,17 @@ int main() {
     }
     // Create a graph with GRAPH_SIZE nodes
     AntGraph* g = create_ant_graph(GRAPH_SIZE);
+    if (!g) {
+        fprintf(stderr, "Failed to allocate the ant graph\n");
+        fclose(logfile);
+        return 1; // exit with error code
+    }
     // Add chain edges (sequential nodes connected in a line)
     // Each edge has weight 1.1 and initial pheromone set to 1.0
     for (int i = 0; i < GRAPH_SIZE - 1; i++) {
         add_edge(g, i, i + 1, 1.1);
-        g->edges[i][i+1].pheromone = g->edges[i+1][i].pheromone = 1.0;
+        set_edge_pheromone(&g->edges[i][i+1], 1.0);
+        set_edge_pheromone(&g->edges[i+1][i], 1.0);
     }
 
     // Add shortcut edges (longer jumps across the graph)
@@ -36,54 +41,63 @@ int main() {
     add_edge(g, 30, 45, 3.0);
 
     // Initialize pheromone levels on some shortcut edges to be very high
-    g->edges[0][10].pheromone  = g->edges[10][0].pheromone  = 50.0;
-    g->edges[5][15].pheromone  = g->edges[15][5].pheromone  = 50.0;
-    g->edges[10][25].pheromone = g->edges[25][10].pheromone = 50.0;
+    int boosted[3][2] = {{0, 10}, {5, 15}, {10, 25}};
+    for (int k = 0; k < 3; k++) {
+        set_edge_pheromone(&g->edges[boosted[k][0]][boosted[k][1]], 50.0);
+        set_edge_pheromone(&g->edges[boosted[k][1]][boosted[k][0]], 50.0);
+    }
 
-    // Create and configure the ant colony
+    // Create the ant colony with defaults and an allocated global best path
     AntColony colony;
-    colony.num_ants = NUM_ANTS;
-    colony.alpha = 1.0; // pheromone influence (higher = stronger bias toward pheromone trails)
-    colony.beta = 3.0; // heuristic influence (higher = stronger bias toward shorter edges)
-    colony.evaporation_rate = 0.5; // pheromone evaporation rate (slower evaporation preserves trails longer)
-    colony.deposit_amount = 10.0; // pheromone deposited per ant per path
-
-    // Initialize global best path tracking
-    colony.global_best_length = INT_MAX; // no best path yet
-    colony.global_best_capacity = GRAPH_SIZE; // maximum possible path length
-    colony.global_best_path = malloc(GRAPH_SIZE * sizeof(int));
-    if (!colony.global_best_path) {
+    if (init_ant_colony(&colony, GRAPH_SIZE) != 0) {
         perror("Failed to allocate global best path");
         free_ant_graph(g);
         fclose(logfile);
         return 1; // exit if memory allocation fails
     }
+    // Configure the colony parameters
+    colony.num_ants = NUM_ANTS;
+    colony.alpha = 1.0; // pheromone influence (higher = stronger bias toward pheromone trails)
+    colony.beta = 3.0; // heuristic influence (higher = stronger bias toward shorter edges)
+    colony.evaporation_rate = 0.5; // pheromone evaporation rate (slower evaporation preserves trails longer)
+    colony.deposit_amount = 10.0; // pheromone deposited per ant per path
 
     // Additional colony settings
     colony.prevent_backtracking = 1; // ants cannot immediately return to the previous node
-    colony.max_steps = GRAPH_SIZE; // maximum steps allowed in a path
     colony.use_global_best_update = 0; // iteration-best ants deposit pheromone (not just global best)
+    colony.console = stdout; // echo progress to the console
+    colony.convergence_csv = "convergence.csv"; // record convergence data
+
+    // Collect hot-path counters and phase timers, dumped as JSON after each iteration
+    AcoStats stats = {0};
+    stats.json_out = fopen("aco_stats.jsonl", "w");
+    if (!stats.json_out) perror("Failed to open stats file"); // stats still collected, just not dumped
+    colony.stats = &stats;
+
+    // Format and write per-iteration output on a background thread
+    colony.logger = aco_logger_create(stdout, logfile, colony.convergence_csv, 1 << 20, ACO_LOG_BLOCK);
+    if (!colony.logger) perror("Failed to start background logger"); // fall back to synchronous logging
 
     // Measure runtime of the ACO run
-    clock_t start = clock(); // start timing
-    run_aco(g, &colony, 0, GRAPH_SIZE - 1, 50, logfile); // run ACO from node 0 to last node 
-    clock_t end = clock(); // end timing
-    double runtime_sec = (double)(end - start) / CLOCKS_PER_SEC; // calculate elapsed time
+    double start = aco_clock_seconds(); // start timing (wall clock: the logger runs on its own thread)
+    int status = run_aco(g, &colony, 0, GRAPH_SIZE - 1, 50, logfile); // run ACO from node 0 to last node
+    if (status != 0) fprintf(stderr, "Memory allocation failed during the ACO run\n");
+    double runtime_sec = aco_clock_seconds() - start; // calculate elapsed time
     fprintf(logfile, "Total runtime: %.3f seconds\n", runtime_sec); // log runtime
     printf("Total runtime: %.3f seconds\n", runtime_sec);
 
-    // Estimate memory usage
-    size_t edge_mem = GRAPH_SIZE * GRAPH_SIZE * sizeof(Edge); // adjacency matrix
-    size_t path_mem = GRAPH_SIZE * sizeof(int); // global best path
-    size_t total_mem = edge_mem + path_mem; // total estimated memory
-    fprintf(logfile, "Estimated memory: %.2f MB\n", total_mem / (1024.0 * 1024.0)); // convert to MB
-    printf("Estimated memory: %.2f MB\n", total_mem / (1024.0 * 1024.0));
+    // Report measured counters, phase timings and peak memory
+    print_aco_stats(&stats, logfile);
+    print_aco_stats(&stats, stdout);
 
     // Clean up memory and close files
-    free(colony.global_best_path);
+    aco_logger_destroy(colony.logger);
+    free_ant_colony(&colony);
     free_ant_graph(g);
+    if (stats.json_out) fclose(stats.json_out);
     fclose(logfile);
 
+    if (status != 0) return 1; // exit with error code
     // Announce program completion
     printf("ACO finished successfully.\n");
     return 0; // exit successfully
@@ -0,0 +1,125 @@
+// precision_bench.c
+// Validation benchmark for the pheromone storage modes. Build it once per
+// mode (see the precision-bench target) and compare the reported costs.
+// Every mode uses the same seeds, so the double build saves its per-seed
+// costs and the other builds compare against them seed by seed.
+#include <stdio.h>
+#include <math.h>
+#include "ant_graph.h"
+#include "graph_gen.h"
+#include "aco_solver.h"
+
+#define NUM_SEEDS 20 // independent runs per graph
+#define NUM_NODES 600 // nodes in every generated graph
+#define NUM_KINDS 3 // graph families benchmarked
+#define REFERENCE_FILE "bench_double_costs.txt" // per-seed costs of the double build
+#define TIE_TOLERANCE 1e-4 // relative cost difference counted as a tie (float weights round)
+
+#if defined(ACO_PHEROMONE_Q16)
+#define MODE_NAME "q16"
+#elif defined(ACO_PHEROMONE_FLOAT)
+#define MODE_NAME "float32"
+#else
+#define MODE_NAME "double"
+#endif
+
+/* Save the double build's per-seed costs (-1 for unsolved runs) */
+void save_reference(double costs[NUM_KINDS][NUM_SEEDS]) {
+    FILE* f = fopen(REFERENCE_FILE, "w");
+    if (!f) {
+        perror("Failed to write reference costs");
+        return;
+    }
+    for (int kind = 0; kind < NUM_KINDS; kind++)
+        for (int s = 0; s < NUM_SEEDS; s++) fprintf(f, "%d %d %.17g\n", kind, s + 1, costs[kind][s]);
+    fclose(f);
+}
+
+/* Load the double build's per-seed costs. Returns 0 on success, -1 if missing or malformed */
+int load_reference(double costs[NUM_KINDS][NUM_SEEDS]) {
+    FILE* f = fopen(REFERENCE_FILE, "r");
+    if (!f) return -1;
+    int loaded = 0, kind, seed;
+    double cost;
+    while (fscanf(f, "%d %d %lf", &kind, &seed, &cost) == 3) {
+        if (kind < 0 || kind >= NUM_KINDS || seed < 1 || seed > NUM_SEEDS) break;
+        costs[kind][seed - 1] = cost;
+        loaded++;
+    }
+    fclose(f);
+    return loaded == NUM_KINDS * NUM_SEEDS ? 0 : -1;
+}
+
+/* Build one of the benchmark graphs for a given seed */
+AntGraph* build_graph(int kind, unsigned long long seed) {
+    switch (kind) {
+        case 0: return generate_erdos_renyi_graph(NUM_NODES, 0.01, seed);
+        case 1: return generate_geometric_graph(NUM_NODES, 0.08, seed);
+        default: return generate_barabasi_albert_graph(NUM_NODES, 2, seed);
+    }
+}
+
+int main() {
+    const char* names[NUM_KINDS] = {"erdos-renyi", "geometric", "barabasi-albert"};
+    static double costs[NUM_KINDS][NUM_SEEDS], reference[NUM_KINDS][NUM_SEEDS];
+    printf("Mode=%s | EdgeBytes=%zu\n", MODE_NAME, sizeof(Edge));
+#if defined(ACO_PHEROMONE_Q16) || defined(ACO_PHEROMONE_FLOAT)
+    int have_reference = (load_reference(reference) == 0);
+    if (!have_reference) printf("No %s: run bench-double first for paired comparisons\n", REFERENCE_FILE);
+#else
+    int have_reference = 0;
+#endif
+    AcoConfig config;
+    aco_default_config(&config);
+    config.num_ants = 20;
+    config.collect_stats = 1;
+    for (int kind = 0; kind < NUM_KINDS; kind++) {
+        double cost_sum = 0.0, construction = 0.0, evaporation = 0.0;
+        int solved = 0;
+        for (int s = 1; s <= NUM_SEEDS; s++) {
+            AntGraph* g = build_graph(kind, s);
+            config.seed = s;
+            AcoSolver* solver = aco_solver_create(&config);
+            aco_solver_attach_graph(solver, g);
+            aco_solver_solve(solver, 0, NUM_NODES - 1, 20);
+            // Average the cost over the runs that found a path
+            costs[kind][s - 1] = -1.0;
+            if (aco_solver_best_length(solver) > 0) {
+                costs[kind][s - 1] = aco_solver_best_cost(solver);
+                cost_sum += costs[kind][s - 1];
+                solved++;
+            }
+            const AcoStats* stats = aco_solver_stats(solver);
+            construction += stats->phase_seconds[ACO_PHASE_CONSTRUCTION];
+            evaporation += stats->phase_seconds[ACO_PHASE_EVAPORATION];
+            aco_solver_destroy(solver);
+            free_ant_graph(g);
+        }
+        double mean = solved ? cost_sum / solved : -1.0;
+        double sq_sum = 0.0; // sample standard deviation over the solved runs
+        for (int s = 0; s < NUM_SEEDS; s++)
+            if (costs[kind][s] >= 0.0) sq_sum += (costs[kind][s] - mean) * (costs[kind][s] - mean);
+        double stddev = solved > 1 ? sqrt(sq_sum / (solved - 1)) : 0.0;
+        printf("Mode=%s | Graph=%s | Solved=%d/%d | MeanBestCost=%.2f | StdDev=%.2f | Construction=%.3fs | Evaporation=%.3fs\n",
+            MODE_NAME, names[kind], solved, NUM_SEEDS, mean, stddev, construction, evaporation);
+        if (!have_reference) continue;
+        // Paired comparison on the seeds both builds solved (lower cost wins)
+        int pairs = 0, wins = 0, ties = 0, losses = 0;
+        double diff_sum = 0.0;
+        for (int s = 0; s < NUM_SEEDS; s++) {
+            if (costs[kind][s] < 0.0 || reference[kind][s] < 0.0) continue;
+            double diff = costs[kind][s] - reference[kind][s];
+            diff_sum += diff;
+            pairs++;
+            if (fabs(diff) <= TIE_TOLERANCE * reference[kind][s]) ties++;
+            else if (diff < 0.0) wins++;
+            else losses++;
+        }
+        printf("    vs double | Pairs=%d | MeanDiff=%+.2f | Wins=%d | Ties=%d | Losses=%d\n",
+            pairs, pairs ? diff_sum / pairs : 0.0, wins, ties, losses);
+    }
+#if !defined(ACO_PHEROMONE_Q16) && !defined(ACO_PHEROMONE_FLOAT)
+    save_reference(costs);
+#endif
+    return 0;
+}
@@ -2,8 +2,27 @@
 #include <stdlib.h>
 #include <limits.h>
 #include <assert.h>
+#include <string.h>
 #include "ant_graph.h"
 #include "aco.h"
+#include "aco_solver.h"
+#include "graph_gen.h"
+
+// Records the improvements reported by an anytime solve
+typedef struct {
+    int calls; // Number of improvements reported
+    int last_length; // Length of the last reported path
+    int ordered; // Cleared if a report was not shorter than the previous one
+} ImproveLog;
+
+// Improvement callback used by the anytime test
+static void record_improvement(const int* path, int path_length, double cost, int iteration, void* user_data) {
+    ImproveLog* log = user_data;
+    if (log->calls > 0 && path_length >= log->last_length) log->ordered = 0;
+    log->calls++;
+    log->last_length = path_length;
+    assert(path[0] == 0 && cost > 0.0 && iteration >= 0);
+}
 
 int main() {
     printf("The Fellowship of the Ants begins their quest...\n");
@@ -51,22 +70,246 @@ int main() {
     colony.prevent_backtracking = 1;
     colony.max_steps = g->num_nodes;
     colony.use_global_best_update = 0;
+    colony.rng_state = 1; // fixed seed: this short run only reinforces both trails for some seeds
+    colony.console = stdout;
+    colony.convergence_csv = "convergence.csv";
+
+    // Collect stats for this run, with one JSON line per iteration
+    AcoStats stats = {0};
+    stats.json_out = tmpfile();
+    assert(stats.json_out);
+    colony.stats = &stats;
 
     printf("\nRunning the Ant Colony Optimization saga...\n");
     run_aco(g, &colony, 0, 3, 3, logfile);
 
     // Assertions to verify pheromone levels
-    double shortcut_pheromone = g->edges[0][3].pheromone;
-    double longpath_pheromone = g->edges[0][1].pheromone;
+    double shortcut_pheromone = edge_pheromone(&g->edges[0][3]);
+    double longpath_pheromone = edge_pheromone(&g->edges[0][1]);
 
     assert(shortcut_pheromone > 1.0);
     assert(longpath_pheromone > 1.0);
     assert(shortcut_pheromone < 10.0);
     assert(longpath_pheromone < 10.0);
 
+    // Assertions to verify the instrumentation saw the run
+    assert(stats.iterations == 3);
+    assert(stats.ant_steps > 0);
+    assert(stats.allocations > 0);
+    assert(stats.phase_seconds[ACO_PHASE_CONSTRUCTION] > 0.0);
+    assert(stats.peak_rss_kb > 0);
+    // The JSON stream has one line per iteration and its counters never go down
+    char json_line[512];
+    long long prev[3] = {0, 0, 0};
+    int json_lines = 0;
+    rewind(stats.json_out);
+    while (fgets(json_line, sizeof(json_line), stats.json_out)) {
+        int it;
+        long long counts[3];
+        assert(sscanf(json_line, "{\"iteration\":%d,\"ant_steps\":%lld,\"dead_ends\":%lld,\"exploration_picks\":%lld,",
+            &it, &counts[0], &counts[1], &counts[2]) == 4);
+        assert(it == ++json_lines);
+        for (int k = 0; k < 3; k++) {
+            assert(counts[k] >= prev[k]);
+            prev[k] = counts[k];
+        }
+    }
+    assert(json_lines == 3);
+    assert(prev[0] == stats.ant_steps && prev[1] == stats.dead_ends && prev[2] == stats.exploration_picks);
+    fclose(stats.json_out);
+
+    // A side road that leads nowhere strands some ants; others wander off at random
+    printf("\nSome ants stray into the Dead Marshes...\n");
+    AntGraph* marsh = create_ant_graph(4);
+    add_edge(marsh, 0, 1, 1.0); // node 1 is a dead end (no way back with backtracking prevented)
+    add_edge(marsh, 0, 2, 1.0);
+    add_edge(marsh, 2, 3, 1.0);
+    AntColony strays;
+    assert(init_ant_colony(&strays, 4) == 0);
+    strays.num_ants = 20;
+    strays.rng_state = 5;
+    AcoStats marsh_stats = {0};
+    strays.stats = &marsh_stats;
+    run_aco(marsh, &strays, 0, 3, 10, NULL);
+    assert(marsh_stats.dead_ends > 0);
+    assert(marsh_stats.exploration_picks > 0);
+    assert(strays.global_best_length == 3); // 0 -> 2 -> 3 is still found
+    free_ant_colony(&strays);
+    free_ant_graph(marsh);
+
+    // Two solver contexts with the same seed sharing one map must agree, and a
+    // repeated solve must not depend on the solves that came before it
+    printf("\nTwo fellowships set out with the same map...\n");
+    AcoConfig config;
+    aco_default_config(&config);
+    config.seed = 42;
+    config.collect_stats = 1;
+    AcoConfig no_ants = config;
+    no_ants.num_ants = 0;
+    assert(aco_solver_create(&no_ants) == NULL); // an invalid config yields no solver
+    AntGraph* map = generate_grid_graph(8, 8, 0.5, 2);
+    AcoSolver* solvers[2];
+    int paths[3][64], lengths[3];
+    double costs[3];
+    for (int s = 0; s < 2; s++) {
+        solvers[s] = aco_solver_create(&config);
+        assert(solvers[s]);
+        assert(aco_solver_solve(solvers[s], 0, 63, 5) == -1); // no graph attached yet
+        assert(aco_solver_attach_graph(solvers[s], map) == 0);
+    }
+    // Solver 0 answers the same query again after solver 1 has run
+    for (int run = 0; run < 3; run++) {
+        AcoSolver* solver = solvers[run == 1];
+        assert(aco_solver_solve(solver, 0, 63, 5) == 0);
+        lengths[run] = aco_solver_best_path(solver, paths[run], 64);
+        costs[run] = aco_solver_best_cost(solver);
+    }
+    assert(lengths[0] > 0 && paths[0][0] == 0 && paths[0][lengths[0] - 1] == 63);
+    for (int run = 1; run < 3; run++) {
+        assert(lengths[run] == lengths[0]);
+        assert(memcmp(paths[run], paths[0], lengths[0] * sizeof(int)) == 0);
+        assert(costs[run] == costs[0]);
+    }
+    assert(aco_solver_stats(solvers[0])->iterations == 5);
+    // The shared map keeps its initial trails: all learning stays inside the solvers
+    for (int i = 0; i < 64; i++)
+        for (int j = 0; j < 64; j++) assert(map->edges[i][j].pheromone == pheromone_encode(1.0));
+    for (int s = 0; s < 2; s++) aco_solver_destroy(solvers[s]);
+    free_ant_graph(map);
+
+    // The background logger must write exactly what synchronous logging writes
+    printf("\nThe scribes record the journey twice...\n");
+    FILE* sync_log = tmpfile();
+    FILE* async_log = tmpfile();
+    assert(sync_log && async_log);
+    for (int pass = 0; pass < 2; pass++) {
+        AntGraph* map = create_ant_graph(4);
+        add_edge(map, 0, 1, 1.0);
+        add_edge(map, 1, 2, 1.0);
+        add_edge(map, 2, 3, 1.0);
+        add_edge(map, 0, 3, 2.0);
+        AntColony scribe;
+        assert(init_ant_colony(&scribe, 4) == 0);
+        scribe.num_ants = 20;
+        scribe.rng_state = 7;
+        if (pass == 0) {
+            run_aco(map, &scribe, 0, 3, 10, sync_log);
+        } else {
+            // The smallest ring (4 KB) wraps several times over this run and exercises backpressure
+            scribe.logger = aco_logger_create(NULL, async_log, NULL, 64, ACO_LOG_BLOCK);
+            assert(scribe.logger);
+            run_aco(map, &scribe, 0, 3, 10, NULL);
+            assert(aco_logger_dropped(scribe.logger) == 0);
+            aco_logger_destroy(scribe.logger);
+        }
+        free_ant_colony(&scribe);
+        free_ant_graph(map);
+    }
+    // Async run logs everything but the header and footer lines written by run_aco
+    char sync_line[256], async_line[256];
+    rewind(sync_log);
+    rewind(async_log);
+    assert(fgets(sync_line, sizeof(sync_line), sync_log)); // skip "Starting ACO..."
+    while (fgets(async_line, sizeof(async_line), async_log)) {
+        assert(fgets(sync_line, sizeof(sync_line), sync_log));
+        assert(strcmp(sync_line, async_line) == 0);
+    }
+    assert(fgets(sync_line, sizeof(sync_line), sync_log) && strncmp(sync_line, "ACO finished", 12) == 0);
+    fclose(sync_log);
+    fclose(async_log);
+
+    // A path longer than the ring is written in place under BLOCK, dropped under DROP
+    FILE* long_log = tmpfile();
+    assert(long_log);
+    static int long_path[2000];
+    for (int i = 0; i < 2000; i++) long_path[i] = i;
+    AcoLogger* blocking = aco_logger_create(NULL, long_log, NULL, 64, ACO_LOG_BLOCK);
+    assert(blocking);
+    assert(aco_logger_push_iteration(blocking, 0) == 0);
+    assert(aco_logger_push_ant_path(blocking, 1, long_path, 2000) == 0);
+    assert(aco_logger_push_ant_path(blocking, 2, long_path, 3) == 0);
+    assert(aco_logger_dropped(blocking) == 0);
+    aco_logger_destroy(blocking);
+    rewind(long_log);
+    char long_line[16384];
+    assert(fgets(long_line, sizeof(long_line), long_log) && strcmp(long_line, "Iteration 1:\n") == 0);
+    assert(fgets(long_line, sizeof(long_line), long_log) && strncmp(long_line, "  Ant 1 path: 0 1 2", 19) == 0);
+    assert(strstr(long_line, " 1999\n"));
+    assert(fgets(long_line, sizeof(long_line), long_log) && strcmp(long_line, "  Ant 2 path: 0 1 2\n") == 0);
+    fclose(long_log);
+    AcoLogger* dropping = aco_logger_create(NULL, NULL, NULL, 64, ACO_LOG_DROP);
+    assert(dropping);
+    assert(aco_logger_push_ant_path(dropping, 1, long_path, 2000) == -1);
+    assert(aco_logger_dropped(dropping) == 1);
+    aco_logger_destroy(dropping);
+
+    // Bidirectional ants must return simple paths made of real edges
+    printf("\nTwo companies march from both ends of the road...\n");
+    AntGraph* road = create_ant_graph(60);
+    for (int i = 0; i < 59; i++) add_edge(road, i, i + 1, 1.0);
+    add_edge(road, 10, 40, 3.0);
+    AntColony twin;
+    assert(init_ant_colony(&twin, 60) == 0);
+    twin.bidirectional = 1;
+    twin.rng_state = 3;
+    int road_path[60], road_length = 0, seen[60];
+    for (int ant = 0; ant < 20; ant++) {
+        build_path(road, 0, 59, 60, road_path, &road_length, &twin);
+        if (road_length == 0) continue; // this ant got stuck
+        assert(road_path[0] == 0 && road_path[road_length - 1] == 59);
+        memset(seen, 0, sizeof(seen));
+        for (int i = 0; i < road_length; i++) {
+            assert(!seen[road_path[i]]); // no node twice
+            seen[road_path[i]] = 1;
+            if (i > 0) assert(road->edges[road_path[i - 1]][road_path[i]].exists);
+        }
+    }
+    run_aco(road, &twin, 0, 59, 10, NULL);
+    assert(twin.global_best_length < INT_MAX);
+    free_ant_colony(&twin);
+    free_ant_graph(road);
+
+    // An anytime solve stops at its deadline and keeps the best path found so far
+    printf("\nThe riders must return before nightfall...\n");
+    AntGraph* realm = generate_grid_graph(20, 20, 0.5, 5);
+    aco_default_config(&config);
+    config.bidirectional = 1;
+    AcoSolver* rider = aco_solver_create(&config);
+    assert(aco_solver_attach_graph(rider, realm) == 0);
+    assert(aco_solver_solve_anytime(rider, 0, 399, 0, 0.0, NULL, NULL) == -1); // no cap and no deadline
+    ImproveLog improvements = {0, 0, 1};
+    double began = aco_clock_seconds();
+    int timed_out = aco_solver_solve_anytime(rider, 0, 399, 0, 30.0, record_improvement, &improvements);
+    double elapsed = aco_clock_seconds() - began;
+    assert(timed_out == 1);
+    assert(elapsed < 0.5); // 30 ms budget plus at most one ant and one iteration's logging
+    assert(improvements.calls > 0 && improvements.ordered);
+    assert(aco_solver_best_length(rider) == improvements.last_length);
+    // A generous budget lets a capped run finish normally
+    assert(aco_solver_solve_anytime(rider, 0, 399, 2, 10000.0, NULL, NULL) == 0);
+    aco_solver_destroy(rider);
+    free_ant_graph(realm);
+
+    // Once the deadline is cleared, a colony that timed out runs iterations again
+    AntGraph* ford = create_ant_graph(3);
+    add_edge(ford, 0, 1, 1.0);
+    add_edge(ford, 1, 2, 1.0);
+    AntColony late;
+    assert(init_ant_colony(&late, 3) == 0);
+    AcoStats late_stats = {0};
+    late.stats = &late_stats;
+    late.deadline = aco_clock_seconds() - 1.0; // already past
+    run_aco(ford, &late, 0, 2, 5, NULL);
+    assert(late.deadline_hit && late_stats.iterations == 0);
+    late.deadline = 0.0;
+    run_iteration(ford, &late, 0, 2, 0, NULL);
+    assert(late_stats.iterations == 1 && late_stats.ant_steps > 0);
+    free_ant_colony(&late);
+    free_ant_graph(ford);
+
     printf("The quest is victorious: pheromone trails shine brighter than before.\n");
 
-    free(colony.global_best_path);
+    free_ant_colony(&colony);
     free_ant_graph(g);
     fclose(logfile);   // close the file
     return 0;
@@ -1,6 +1,7 @@
 #include <stdio.h>
 #include <assert.h>
 #include "ant_graph.h"
+#include "graph_gen.h"
 
 int main() {
     AntGraph* g = create_ant_graph(4); // create a graph with 4 nodes
@@ -13,12 +14,12 @@ int main() {
     print_ant_graph(g); // print the adjacency matrix
 
     // verify edges are present
-    assert(g->edges[0][1].weight == 2.5);
-    assert(g->edges[1][0].weight == 2.5); // undirected
-    assert(g->edges[1][2].weight == 1.0);
-    assert(g->edges[2][1].weight == 1.0); // undirected
-    assert(g->edges[2][3].weight == 3.2);
-    assert(g->edges[3][2].weight == 3.2); // undirected
+    assert(g->edges[0][1].weight == (aco_weight_t)2.5);
+    assert(g->edges[1][0].weight == (aco_weight_t)2.5); // undirected
+    assert(g->edges[1][2].weight == (aco_weight_t)1.0);
+    assert(g->edges[2][1].weight == (aco_weight_t)1.0); // undirected
+    assert(g->edges[2][3].weight == (aco_weight_t)3.2);
+    assert(g->edges[3][2].weight == (aco_weight_t)3.2); // undirected
 
     // verify no edge where none was added
     assert(g->edges[0][2].exists == 0);
@@ -26,8 +27,58 @@ int main() {
     assert(g->edges[1][3].exists == 0);
     assert(g->edges[3][1].exists == 0);
 
-    add_edge(g, 5, 1, 2.0); // invalid edge, should print error message
-    add_edge(g, -1, 2, 1.5); // negative edge, should print error message
+    assert(add_edge(g, 5, 1, 2.0) == -1); // invalid edge is rejected
+    assert(add_edge(g, -1, 2, 1.5) == -1); // negative edge is rejected
+    assert(add_edge(g, 0, 1, 2.5) == 0); // valid edge is accepted
+
+    // this program and the library agree on the pheromone storage mode
+    assert(ant_graph_precision() == ACO_PRECISION);
+    // pheromone survives the storage format (16-bit codes step by ~2e-4 relative)
+    double levels[4] = {0.01, 1.0, 2.5, 10.0};
+    for (int k = 0; k < 4; k++) {
+        set_edge_pheromone(&g->edges[0][1], levels[k]);
+        assert(fabs(edge_pheromone(&g->edges[0][1]) - levels[k]) <= 2e-4 * levels[k]);
+    }
+#if defined(ACO_PHEROMONE_Q16)
+    // 16-bit codes saturate at the ends of [1e-3, 1e3]
+    assert(pheromone_encode(1e-6) == 0 && pheromone_encode(1e6) == 65535);
+    assert(fabs(pheromone_decode(65535) - 1e3) < 1e-6 * 1e3);
+#endif
+    set_edge_pheromone(&g->edges[0][1], 1.0);
+
+    // generated grids have the expected shape
+    AntGraph* grid = generate_grid_graph(3, 4, 0.5, 1);
+    assert(grid->num_nodes == 12);
+    assert(count_ant_graph_edges(grid) == 3 * 3 + 2 * 4); // horizontal + vertical edges
+    assert(grid->edges[0][1].exists && grid->edges[1][0].exists); // undirected
+    assert(grid->edges[0][4].exists && !grid->edges[0][5].exists);
+    assert(grid->edges[0][1].weight >= 1.0 && grid->edges[0][1].weight <= 1.5);
+    free_ant_graph(grid);
+    assert(generate_grid_graph(65536, 65536, 0.0, 1) == NULL); // node count overflows an int
+
+    // scale-free graphs add exactly m edges per node after the seed clique
+    AntGraph* ba = generate_barabasi_albert_graph(200, 3, 7);
+    assert(count_ant_graph_edges(ba) == 3 * 4 / 2 + (200 - 4) * 3);
+    free_ant_graph(ba);
+
+    // geometric edges never exceed the radius (weights are distance / radius)
+    AntGraph* rgg = generate_geometric_graph(300, 0.1, 3);
+    for (int i = 0; i < rgg->num_nodes; i++)
+        for (int j = 0; j < rgg->num_nodes; j++)
+            if (rgg->edges[i][j].exists) assert(rgg->edges[i][j].weight <= 1.0 && rgg->edges[j][i].exists);
+    assert(count_ant_graph_edges(rgg) > 0);
+    free_ant_graph(rgg);
+
+    // the same seed gives the same random graph
+    AntGraph* er1 = generate_erdos_renyi_graph(100, 0.05, 11);
+    AntGraph* er2 = generate_erdos_renyi_graph(100, 0.05, 11);
+    int er_edges = count_ant_graph_edges(er1);
+    assert(er_edges == count_ant_graph_edges(er2));
+    assert(er_edges > 100 && er_edges < 400); // expected about 0.05 * 4950 = 247
+    for (int i = 0; i < 100; i++)
+        for (int j = 0; j < 100; j++) assert(er1->edges[i][j].weight == er2->edges[i][j].weight);
+    free_ant_graph(er1);
+    free_ant_graph(er2);
 
     printf("All tests passed! Even Mordor cannot break this code.\n");
 